@@ -26,6 +26,204 @@
 	#define DEBUG_PRINTLN(x)
 #endif
 
+//-- MATRIX Helpers -------------
+// position (row << 3 | column) in the display buffer of pixel x/y for the 4 rotations.
+// kniwwelino hardware specific: the columns are mirrored.
+static constexpr uint8_t _matrixMap(uint8_t rot, uint8_t x, uint8_t y) {
+	return (rot == 0) ? (((4-x) << 3) | y) :
+		   (rot == 2) ? ((x << 3) | (4-y)) :
+		   (rot == 3) ? (((4-y) << 3) | (4-x)) :
+		   ((y << 3) | x);
+}
+#define MATRIX_MAP_ROW(r, y) _matrixMap(r, 0, y), _matrixMap(r, 1, y), _matrixMap(r, 2, y), _matrixMap(r, 3, y), _matrixMap(r, 4, y)
+#define MATRIX_MAP(r) { MATRIX_MAP_ROW(r, 0), MATRIX_MAP_ROW(r, 1), MATRIX_MAP_ROW(r, 2), MATRIX_MAP_ROW(r, 3), MATRIX_MAP_ROW(r, 4) }
+// indexed by [rotation][y*5 + x]
+static constexpr uint8_t matrixMap[4][25] = { MATRIX_MAP(0), MATRIX_MAP(1), MATRIX_MAP(2), MATRIX_MAP(3) };
+// unknown rotations behave like rotation 1 (no mirroring/swapping).
+#define MATRIX_MAP_FOR(rot) matrixMap[(rot) < 4 ? (rot) : 1]
+
+//-- PARSER Helpers -------------
+/*
+ * parses a decimal number like "2", "-1" or "0.5" into 1/10 units.
+ * returns the number of characters used, 0 if there is no number.
+ */
+static uint16_t _parseTenths(const char* s, uint16_t len, int32_t &value) {
+	uint16_t pos = 0;
+	boolean negative = false;
+	boolean digits = false;
+	int32_t v = 0;
+	if (pos < len && s[pos] == '-') {
+		negative = true;
+		pos++;
+	}
+	while (pos < len && s[pos] >= '0' && s[pos] <= '9') {
+		v = v * 10 + (s[pos++] - '0');
+		digits = true;
+	}
+	v *= 10;
+	if (pos < len && s[pos] == '.') {
+		pos++;
+		if (pos < len && s[pos] >= '0' && s[pos] <= '9') {
+			v += s[pos] - '0';
+			digits = true;
+		}
+		while (pos < len && s[pos] >= '0' && s[pos] <= '9') pos++;
+	}
+	if (!digits) return 0;
+	value = negative ? -v : v;
+	return pos;
+}
+
+/*
+ * returns the value of a hex digit, -1 if c is none.
+ */
+static int8_t _hexDigit(char c) {
+	if (c >= '0' && c <= '9') return c - '0';
+	if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+	return -1;
+}
+
+//-- EFFECT Helpers -------------
+// brightness curves of the RGB_/PIN_ effects, one entry per tick.
+// glow and fade are stretched at the dark end, so they look even to the eye.
+static const uint8_t PROGMEM _curveSpark[] = {	// halves every tick, no correction
+	255, 128, 64, 32, 16, 8, 4, 2
+};
+static const uint8_t PROGMEM _curveGlow[] = {		// sine, 2.4 sec
+	1, 1, 1, 1, 2, 3, 6, 10, 15, 23, 33, 46, 60, 78, 97, 118,
+	139, 161, 183, 203, 220, 235, 246, 253, 255, 253, 246, 235, 220, 203, 183, 161,
+	139, 118, 97, 78, 60, 46, 33, 23, 15, 10, 6, 3, 2, 1, 1, 1
+};
+static const uint8_t PROGMEM _curveFade[] = {		// ramp, 1 sec, played backwards for fade out
+	0, 2, 4, 7, 12, 18, 25, 34, 44, 55, 68, 83, 99, 116, 135, 156,
+	178, 202, 228, 255
+};
+
+//-- PIN Helpers -------------
+/*
+ * sets an output pin directly in the GPIO registers, GPIO16 (D0) has its own register.
+ */
+static inline void _pinWrite(uint8_t pin, boolean high) {
+	if (pin == 16) {
+		if (high) GP16O |= 1; else GP16O &= ~1;
+	} else if (high) {
+		GPOS = bit(pin);
+	} else {
+		GPOC = bit(pin);
+	}
+}
+
+//-- COLOR Helpers -------------
+// color of a hue (0-255) on the red-blue-green wheel used by RGBhue2int
+static constexpr uint32_t _hueColor(uint8_t h) {
+	return (h < 85) ? (((uint32_t)(255 - h * 3) << 16) | (h * 3)) :
+		   (h < 170) ? (((uint32_t)((h - 85) * 3) << 8) | (255 - (h - 85) * 3)) :
+		   (((uint32_t)((h - 170) * 3) << 16) | ((uint32_t)(255 - (h - 170) * 3) << 8));
+}
+#define HUE_4(h) _hueColor(255-(h)), _hueColor(254-(h)), _hueColor(253-(h)), _hueColor(252-(h))
+#define HUE_16(h) HUE_4(h), HUE_4(h+4), HUE_4(h+8), HUE_4(h+12)
+#define HUE_64(h) HUE_16(h), HUE_16(h+16), HUE_16(h+32), HUE_16(h+48)
+// indexed by hue
+static const uint32_t PROGMEM _hueTable[256] = { HUE_64(0), HUE_64(64), HUE_64(128), HUE_64(192) };
+
+struct KniwwelinoColorName {
+	char name[8];
+	uint32_t color;
+};
+static const KniwwelinoColorName PROGMEM _colorNames[] = {
+	{ "off", 0x000000 }, { "black", 0x000000 }, { "white", 0xFFFFFF },
+	{ "red", RGB_COLOR_RED }, { "green", RGB_COLOR_GREEN }, { "blue", RGB_COLOR_BLUE },
+	{ "yellow", 0xFFFF00 }, { "cyan", RGB_COLOR_CYAN }, { "magenta", 0xFF00FF },
+	{ "orange", RGB_COLOR_ORANGE }, { "purple", 0x800080 }, { "pink", 0xFF69B4 }
+};
+
+/*
+ * parses a decimal number, returns the number of characters used, 0 if there is none.
+ */
+static uint16_t _parseInt(const char* s, uint16_t len, int32_t &value) {
+	uint16_t pos = 0;
+	int32_t v = 0;
+	while (pos < len && s[pos] >= '0' && s[pos] <= '9' && pos < 9) v = v * 10 + (s[pos++] - '0');
+	if (pos > 0) value = v;
+	return pos;
+}
+
+//-- TONE Helpers -------------
+// formats of the queued melodies
+#define TONE_FORMAT_ARRAY	0
+#define TONE_FORMAT_RTTTL	1
+#define TONE_FORMAT_PACKED	2
+
+// highest octave, lower octaves are derived by halving
+static const uint16_t PROGMEM _toneOctave8[12] = {
+	4186, 4435, 4699, 4978, 5274, 5588, 5920, 6272, 6645, 7040, 7459, 7902
+};
+
+static uint16_t _toneFrequency(uint8_t semitone, uint8_t octave) {
+	uint8_t shift = 8 - constrain(octave, 0, 8);
+	return (pgm_read_word(&_toneOctave8[semitone % 12]) + ((1 << shift) >> 1)) >> shift;
+}
+
+/*
+ * reads a number of a RTTTL string, RAM or PROGMEM.
+ */
+static uint16_t _toneNumber(const char* s, uint16_t &pos) {
+	uint16_t v = 0;
+	char c;
+	while ((c = pgm_read_byte(s + pos)) >= '0' && c <= '9') {
+		v = v * 10 + (c - '0');
+		pos++;
+	}
+	return v;
+}
+
+//-- MQTT Helpers -------------
+// internal routes of the dispatch table
+#define MQTT_ROUTE_PWD		1
+#define MQTT_ROUTE_UPDATE	2
+#define MQTT_ROUTE_LOG		3
+#define MQTT_ROUTE_RGB		4
+#define MQTT_ROUTE_ICON		5
+#define MQTT_ROUTE_TEXT		6
+
+// FNV-1a
+static uint32_t _mqttHash(const char* s) {
+	uint32_t h = 2166136261UL;
+	while (*s) h = (h ^ (uint8_t) *s++) * 16777619UL;
+	return h;
+}
+
+/*
+ * matches a topic against a subscription with + (one level) and # (all below) wildcards.
+ */
+static boolean _mqttMatch(const char* pattern, const char* topic) {
+	while (*pattern) {
+		if (*pattern == '#') return true;
+		if (*pattern == '+') {
+			while (*topic && *topic != '/') topic++;
+			pattern++;
+			continue;
+		}
+		if (*pattern != *topic) {
+			// "a/#" matches "a" as well
+			return *topic == 0 && strcmp(pattern, "/#") == 0;
+		}
+		pattern++;
+		topic++;
+	}
+	return *topic == 0;
+}
+
+//-- ICON Helpers -------------
+/*
+ * only reached if an invalid "..."_icon literal is evaluated at runtime.
+ */
+uint32_t KniwwelinoIconError_invalid_icon_string() {
+	DEBUG_PRINTLN(F("invalid icon literal"));
+	return 0;
+}
+
 //-- CALLBACK Helpers -------------
 typedef void (*MQTTClientCallbackSimple)(String &topic, String &payload);
 MQTTClientCallbackSimple mqttCallback = nullptr;
@@ -36,6 +234,17 @@ MQTTClientCallbackSimple mqttCallback = nullptr;
  */
 KniwwelinoLib::KniwwelinoLib() : Adafruit_GFX(5, 5) {
   RGB = Adafruit_NeoPixel(1, RGB_PIN, NEO_GRB + NEO_KHZ800);
+
+  // background tasks, the display is flushed every tick, the buttons are read on odd ticks
+  // when no flush is due (the flush goes first, see _baseTick)
+  for (uint8_t i = 0; i < TASK_MAX; i++) {
+	  _TASKsetup(i, nullptr, 0, 0, false);
+  }
+  _TASKsetup(TASK_PINS,		&KniwwelinoLib::_PINhandle,		1, 0, false);
+  _TASKsetup(TASK_RGB,		&KniwwelinoLib::_RGBblink,		1, 0, false);
+  _TASKsetup(TASK_MATRIX,	&KniwwelinoLib::_MATRIXupdate,	1, 0, false);
+  _TASKsetup(TASK_DISPLAY,	&KniwwelinoLib::_MATRIXflush,	1, 0, true);
+  _TASKsetup(TASK_BUTTONS,	&KniwwelinoLib::_Buttonsread,	2, 1, true);
 }
 
 /*
@@ -111,6 +320,16 @@ void KniwwelinoLib::begin(const char nameStr[], boolean enableWifi, boolean fast
 	Wire.beginTransmission(HT16K33_ADDRESS);
 	Wire.write(0x21);  // turn on oscillator
 	Wire.endTransmission();
+	// display RAM content unknown -> send all rows on the first update
+	matrixShadowValid = false;
+
+	// same PWM range on all cores (core 3.x defaults to 255)
+	analogWriteRange(PIN_PWM_RANGE);
+	// pin and melody timers, armed and disarmed by the PIN/TONE functions from now on
+	for (uint8_t i = 0; i < PIN_COUNT; i++) {
+		os_timer_setfn(&ioPinTimer[i], _PINtimer, (void*)(uintptr_t) i);
+	}
+	os_timer_setfn(&toneTimer, _TONEtimer, nullptr);
 
 	// init LED MATRIX
 	setTextWrap(false);
@@ -149,7 +368,7 @@ void KniwwelinoLib::begin(const char nameStr[], boolean enableWifi, boolean fast
 	MATRIXsetStatus(0);
 
 	// attach base ticker for display and buttons
-	baseTicker.attach(TICK_FREQ, _baseTick);
+	_TICKattach(TICK_FREQ * 1000);
 	_baseTick();
 	// BOOT: ticker running
 	MATRIXsetStatus(1);
@@ -337,30 +556,317 @@ void KniwwelinoLib::setSilent() {
 		bgI2C=true;
 	}
 
+	//====  Effect curves ========================================================
+
+	/*
+	 * Sets the brightness curve used by the RGB_CURVE and PIN_CURVE effects.
+	 * curve = array of brightness values (0-255), one per tick (50ms), played in a loop.
+	 * len = number of values (1-255)
+	 *
+	 * the array must stay valid while the effect is used.
+	 */
+	void KniwwelinoLib::CURVEset(const uint8_t* curve, uint8_t len) {
+		// never let the ticker see the new curve with the old length
+		curveUserLen = 0;
+		curveUser = curve;
+		curveUserLen = (curve != nullptr) ? len : 0;
+	}
+
+	/*
+	 * internal function that returns the brightness of a curve effect and moves to the next tick.
+	 * phase = position in the curve, kept by the caller.
+	 * returns true when the curve has been played once.
+	 */
+	boolean KniwwelinoLib::_CURVEstep(uint8_t effect, uint8_t& phase, uint8_t& level) {
+		const uint8_t* table;
+		uint8_t len;
+		switch (effect) {
+		case RGB_SPARK:
+			table = _curveSpark; len = sizeof(_curveSpark);
+			break;
+		case RGB_GLOW:
+			table = _curveGlow; len = sizeof(_curveGlow);
+			break;
+		case RGB_FADE_IN:
+		case RGB_FADE_OUT:
+			table = _curveFade; len = sizeof(_curveFade);
+			break;
+		default:
+			if (curveUserLen == 0) {
+				level = 0;
+				return true;
+			}
+			if (phase >= curveUserLen) phase = 0;
+			level = curveUser[phase];
+			return (++phase >= curveUserLen) ? (phase = 0, true) : false;
+		}
+
+		if (phase >= len) phase = 0;
+		level = pgm_read_byte(table + (effect == RGB_FADE_OUT ? len - 1 - phase : phase));
+		return (++phase >= len) ? (phase = 0, true) : false;
+	}
+
+	//====  I2C bus arbitration ==================================================
+
+	/*
+	 * Queues an I2C transaction with the background matrix and button traffic.
+	 * It is done in the next loop()/sleep(), so it never collides with the background.
+	 * transaction->status is I2C_PENDING until done, then 0 or the Wire error code.
+	 * transaction->done is called from loop()/sleep() as well, never from the ticker.
+	 * transaction must stay valid until it is done.
+	 *
+	 * returns false if the queue is full.
+	 */
+	boolean KniwwelinoLib::I2Csubmit(KniwwelinoI2C* transaction) {
+		uint8_t head = i2cHead;
+		if ((uint8_t)(head - i2cTail) >= I2C_QUEUE_SIZE) return false;
+		transaction->status = I2C_PENDING;
+		i2cQueue[head & (I2C_QUEUE_SIZE - 1)] = transaction;
+		i2cHead = head + 1;
+		if (!(workQueued & bit(WORK_I2C))) _WORKpost(WORK_I2C);
+		return true;
+	}
+
+	/*
+	 * Does an I2C transaction right now, after the queued background work.
+	 * writes txLen bytes of tx and then reads rxLen bytes into rx (both may be 0).
+	 * returns 0 if ok, else the Wire error code or I2C_ERR_READ.
+	 */
+	int8_t KniwwelinoLib::I2Ctransfer(uint8_t address, const uint8_t* tx, uint8_t txLen, uint8_t* rx, uint8_t rxLen) {
+		_WORKdrain();
+		KniwwelinoI2C t = { address, tx, txLen, rx, rxLen, nullptr, I2C_PENDING };
+		_I2Crun(&t);
+		return t.status;
+	}
+
+	void KniwwelinoLib::_I2Crun(KniwwelinoI2C* t) {
+		int8_t status = 0;
+		if (t->txLen > 0 || t->rxLen == 0) {
+			Wire.beginTransmission(t->address);
+			Wire.write(t->tx, t->txLen);
+			status = Wire.endTransmission();
+		}
+		if (status == 0 && t->rxLen > 0) {
+			if (Wire.requestFrom(t->address, t->rxLen) != t->rxLen) {
+				status = I2C_ERR_READ;
+			} else {
+				for (uint8_t i = 0; i < t->rxLen; i++) t->rx[i] = Wire.read();
+			}
+		}
+		t->status = status;
+		if (t->done != nullptr) t->done(t);
+	}
+
+	/*
+	 * internal function used by the ticker to hand bus work to loop()/sleep().
+	 * every kind of work is queued only once.
+	 */
+	void KniwwelinoLib::_WORKpost(uint8_t work) {
+		tickI2CUsed = true;
+		if (workQueued & bit(work)) return;
+		uint8_t head = workHead;
+		if ((uint8_t)(head - workTail) >= WORK_QUEUE_SIZE) return;
+		workQueue[head & (WORK_QUEUE_SIZE - 1)] = work;
+		workQueued |= bit(work);
+		workHead = head + 1;
+	}
+
+	/*
+	 * internal function that does the queued bus work.
+	 * called by loop()/sleep() and by the ticker if they are not called for a while.
+	 * userI2C = false leaves the I2Csubmit transactions queued, so their done
+	 * callbacks always run in loop()/sleep().
+	 */
+	void KniwwelinoLib::_WORKdrain(boolean userI2C) {
+		workAge = 0;
+		boolean i2cLeft = false;
+		// button interrupt, read right away instead of waiting for the next tick
+		if (buttonsIRQ && !(workQueued & bit(WORK_BUTTONS))) _Buttonsscan();
+		while (workTail != workHead) {
+			uint8_t tail = workTail;
+			uint8_t work = workQueue[tail & (WORK_QUEUE_SIZE - 1)];
+			workQueued &= ~bit(work);
+			workTail = tail + 1;
+
+			switch (work) {
+			case WORK_DISPLAY:
+				_MATRIXsend();
+				break;
+			case WORK_BUTTONS:
+				_Buttonsscan();
+				break;
+			case WORK_I2C:
+				if (!userI2C) {
+					i2cLeft = true;
+					break;
+				}
+				while (i2cTail != i2cHead) {
+					uint8_t t = i2cTail;
+					KniwwelinoI2C* transaction = i2cQueue[t & (I2C_QUEUE_SIZE - 1)];
+					i2cTail = t + 1;
+					_I2Crun(transaction);
+				}
+				break;
+			}
+		}
+		if (i2cLeft) _WORKpost(WORK_I2C);
+	}
+
+	/*
+	 * Runs one background tick (LEDs, matrix, buttons) right now.
+	 * Together with bgTickStop() this allows a sketch to drive the
+	 * background handling itself, e.g. to measure how long a tick takes.
+	 */
+	void KniwwelinoLib::bgTick() {
+		_baseTick();
+	}
+
+	/*
+	 * Stops the background ticker. Matrix, RGB LED, pins and buttons
+	 * are no longer updated until bgTickStart() is called.
+	 */
+	void KniwwelinoLib::bgTickStop() {
+		tickRunning = false;
+		_TICKattach(0);
+	}
+
+	/*
+	 * (Re)starts the background ticker.
+	 */
+	void KniwwelinoLib::bgTickStart() {
+		tickRunning = true;
+		tickIdle = false;
+		_TICKattach(TICK_FREQ * 1000);
+	}
+
+	/*
+	 * Lets the background ticker slow down while there is nothing to do
+	 * (static matrix and LED, no pin effects, no scrolling, animation or countdown).
+	 * It runs at full speed again on the next API call that changes something or a button press.
+	 * If the buttons use the interrupt (BUTTONsetInterruptPin) and no pin is used as button,
+	 * the ticker is stopped completely, giving WiFi modem-/light-sleep a chance.
+	 *
+	 * idleMillis = tick period when idle, e.g. 250. (0 = always tick every 50ms, default)
+	 */
+	void KniwwelinoLib::bgTickIdle(uint16_t idleMillis) {
+		tickIdleMillis = idleMillis;
+		if (idleMillis == 0) _TICKwake();
+	}
+
+	/*
+	 * internal function that checks if all background tasks are idle.
+	 */
+	boolean KniwwelinoLib::_TICKisIdle() {
+		for (uint8_t i = 0; i < TASK_MAX; i++) {
+			if (i == TASK_DISPLAY || i == TASK_BUTTONS) continue;
+			if (tasks[i].period > 0 && !tasks[i].idle) return false;
+		}
+		if (redrawMatrix || workHead != workTail) return false;
+		if (buttonA || buttonB || buttonsIRQ) return false;
+		for (uint8_t i = 0; i < EVENT_SOURCES; i++) {
+			if (gestures[i].down || gestures[i].raw || gestures[i].clicks > 0) return false;
+		}
+		return true;
+	}
+
+	void KniwwelinoLib::_TICKsetIdle(boolean idle) {
+		if (!tickRunning || idle == tickIdle) return;
+		tickIdle = idle;
+		if (!idle) {
+			_TICKattach(TICK_FREQ * 1000);
+		} else if (buttonsIntPin >= 0 && tasks[TASK_PINS].idle) {
+			// buttons wake us by interrupt
+			_TICKattach(0);
+		} else {
+			// keep polling the buttons slowly
+			_TICKattach(tickIdleMillis);
+		}
+	}
+
+	/*
+	 * internal function that (re)arms the base ticker, periodMs = 0 stops it.
+	 * the profiling measures the skipped ticks against this period from the next tick on.
+	 */
+	void KniwwelinoLib::_TICKattach(uint16_t periodMs) {
+		if (periodMs == 0) {
+			baseTicker.detach();
+		} else {
+			baseTicker.attach_ms(periodMs, _baseTick);
+		}
+		tickPeriodMicros = periodMs * 1000UL;
+		profileTickRestart = true;
+	}
+
+	/*
+	 * internal function, back to the full tick rate after the ticker went idle.
+	 */
+	void KniwwelinoLib::_TICKwake() {
+		if (tickIdle) _TICKsetIdle(false);
+	}
+
+	/*
+	 * internal function, a task that went idle has new work.
+	 */
+	void KniwwelinoLib::_TASKwake(uint8_t id) {
+		tasks[id].idle = false;
+		_TICKwake();
+	}
+
 	/*
 	 * Sleeps the current program for the given number of milli seconds.
 	 * Use this one instead of arduino delay, as it handles Wifi and MQTT in the background.
 	 */
 	void KniwwelinoLib::sleep(unsigned long sleepMillis) {
 		yield();
+		_WORKdrain();
 		if (sleepMillis < 100) {
 			delay(sleepMillis);
-		} else {
-			unsigned long till = millis() + sleepMillis;
-			while (till > millis()) {
-				yield();
+			return;
+		}
+		unsigned long start = millis();
+		unsigned long slept;
+		while ((slept = millis() - start) < sleepMillis) {
+			yield();
+			_WORKdrain();
+
+			if (mqttEnabled && mqtt.connected()) {
+				mqtt.loop();
+				_ADCsend();
+			}
 
-				if (mqttEnabled && mqtt.connected()) {
-					mqtt.loop();
-				}
+			delay(min(sleepMillis - slept, 100UL));
+		}
+	}
 
-				sleepMillis = till - millis();
-				if (sleepMillis > 100) {
-					delay(100);
-				} else {
-					delay(sleepMillis);
-				}
+	/*
+	 * Sleeps like sleep() but wakes up early if one of the given things happens.
+	 * unlike sleep(), MQTT messages and input are handled every milli second while sleeping.
+	 *
+	 * events = SLEEP_MQTT (message received) | SLEEP_BUTTON (button event) | SLEEP_PIN (pin button event)
+	 *          or SLEEP_ANY, see EVENTpoll() for the button and pin events.
+	 * timeout = max. time to sleep in milli seconds.
+	 *
+	 * returns the reason for waking up (SLEEP_MQTT/SLEEP_BUTTON/SLEEP_PIN) or SLEEP_TIMEOUT.
+	 */
+	uint8_t KniwwelinoLib::sleepUntil(uint8_t events, unsigned long timeout) {
+		unsigned long start = millis();
+		sleepWake = 0;
+		yield();
+		while (true) {
+			_WORKdrain();
+
+			if (mqttEnabled && mqtt.connected()) {
+				mqtt.loop();
+				_ADCsend();
+			}
+
+			uint8_t wake = sleepWake & events;
+			if (wake != 0) {
+				// report one reason, MQTT first
+				return wake & (uint8_t)(-wake);
 			}
+			if (millis() - start >= timeout) return SLEEP_TIMEOUT;
+			delay(1);
 		}
 	}
 
@@ -370,6 +876,7 @@ void KniwwelinoLib::setSilent() {
 	 */
 	void KniwwelinoLib::loop() {
 		yield();
+		_WORKdrain();
 	    if (mqttEnabled) {
 	    	if (!mqtt.connected()) {
 	    		MQTTconnect();
@@ -378,20 +885,275 @@ void KniwwelinoLib::setSilent() {
 	    	if (mqtt.connected()) {
 	    		mqtt.loop();
 	    		_MQTTupdateStatus(false);
+	    		_ADCsend();
 	    	}
 	    }
 	}
 
 	/*
 	 * internal ticker function that is called in the background.
-	 * handles the update of LED, MAtrix and reads the buttons.
+	 * runs the background tasks (LED, Matrix, buttons, user tasks) that are due.
+	 * a task is due if _tick % period == phase.
+	 * only one task per tick may use the I2C bus, others are deferred to the next tick.
+	 * tasks run in id order, so a pending display flush always goes before a button read.
+	 * the bus work itself is done by loop()/sleep() (see _WORKdrain).
 	 */
 	void KniwwelinoLib::_baseTick() {
 		_tick++;
-		Kniwwelino._PINhandle();
-		Kniwwelino._RGBblink();
-		Kniwwelino._Buttonsread();
-		Kniwwelino._MATRIXupdate();
+		KniwwelinoLib &k = Kniwwelino;
+		uint32_t start = 0;
+		if (k.profileEnabled) {
+			k._PROFILEtickStart();
+			start = ESP.getCycleCount();
+		}
+
+		k.tickI2CUsed = false;
+		// deferred tasks and the ones due in this tick
+		for (uint8_t i = 0; i < TASK_MAX; i++) {
+			Task &t = k.tasks[i];
+			if (t.period == 0) continue;
+			if (!t.pending && (t.idle || (_tick % t.period) != t.phase)) continue;
+			if (t.i2c && k.tickI2CUsed) {
+				t.pending = true;
+				continue;
+			}
+			t.pending = false;
+			k._TASKrun(i);
+		}
+
+		// loop() is blocked (e.g. delay() in the sketch), do the bus work here
+		if (k.workHead != k.workTail && ++k.workAge >= WORK_MAX_DELAY) {
+			k._WORKdrain(false);
+		}
+
+		if (k.profileEnabled) {
+			uint32_t cycles = ESP.getCycleCount() - start;
+			k._PROFILEadd(PROFILE_TICK, cycles);
+			k.profileTicks++;
+			if (cycles / ESP.getCpuFreqMHz() > k.profileBudget) {
+				k.profileOverruns++;
+			}
+		}
+
+		if (k.tickIdleMillis > 0) k._TICKsetIdle(k._TICKisIdle());
+	}
+
+	void KniwwelinoLib::_TASKrun(uint8_t id) {
+		uint32_t start = 0;
+		if (profileEnabled) start = ESP.getCycleCount();
+
+		Task &t = tasks[id];
+		if (t.method != nullptr) {
+			(this->*t.method)();
+		} else {
+			t.function();
+		}
+
+		if (profileEnabled) _PROFILEadd(id, ESP.getCycleCount() - start);
+	}
+
+	void KniwwelinoLib::_TASKsetup(uint8_t id, void (KniwwelinoLib::*method)(), uint16_t period, uint16_t phase, boolean i2c) {
+		Task &t = tasks[id];
+		t.method = method;
+		t.function = nullptr;
+		t.period = period;
+		t.phase = (period > 0) ? phase % period : 0;
+		t.i2c = i2c;
+		t.pending = false;
+		t.idle = false;
+	}
+
+	//====  Background tasks =====================================================
+
+	/*
+	 * Adds a function that is called in the background every period ticks (1 tick = 50ms).
+	 * Keep it short, it runs in the ticker. Do not use I2C in there.
+	 *
+	 * task = function to be called
+	 * period = call every period ticks
+	 * phase = tick offset (0 - period-1), to spread tasks over the ticks.
+	 *
+	 * returns the task id, -1 if no more tasks can be added.
+	 */
+	int KniwwelinoLib::TASKadd(void (*task)(), uint16_t period, uint16_t phase) {
+		if (task == nullptr) return -1;
+		for (uint8_t i = TASK_USER; i < TASK_MAX; i++) {
+			if (tasks[i].function == nullptr) {
+				_TASKsetup(i, nullptr, 0, 0, false);
+				tasks[i].function = task;
+				TASKsetPeriod(i, period, phase);
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	/*
+	 * Removes the given user task.
+	 */
+	void KniwwelinoLib::TASKremove(uint8_t id) {
+		if (id < TASK_USER || id >= TASK_MAX) return;
+		tasks[id].period = 0;
+		tasks[id].function = nullptr;
+	}
+
+	/*
+	 * Changes when a background task runs.
+	 * id = TASK_PINS/TASK_RGB/TASK_MATRIX/TASK_DISPLAY/TASK_BUTTONS or an id returned by TASKadd.
+	 * period = run every period ticks, 0 stops the task.
+	 * phase = tick offset (0 - period-1)
+	 *
+	 * e.g. TASKsetPeriod(TASK_BUTTONS, 4, 1) reads the buttons every 200ms.
+	 * TASK_DISPLAY (period 1) and TASK_BUTTONS (period 2, phase 1) share the bus,
+	 * a button read is deferred by a tick while the display is flushed.
+	 */
+	void KniwwelinoLib::TASKsetPeriod(uint8_t id, uint16_t period, uint16_t phase) {
+		if (id >= TASK_MAX) return;
+		Task &t = tasks[id];
+		if (t.method == nullptr && t.function == nullptr) return;
+		t.phase = (period > 0) ? phase % period : 0;
+		t.period = period;
+		t.pending = false;
+	}
+
+	//====  Tick profiling =======================================================
+
+	/*
+	 * internal function called at the start of every tick while profiling is on.
+	 */
+	void KniwwelinoLib::_PROFILEtickStart() {
+		// detect ticks the Ticker could not deliver in time,
+		// not for ticks called directly (bgTick) or the first one after (re)arming
+		uint32_t now = micros();
+		uint32_t period = tickPeriodMicros;
+		if (period > 0 && !profileTickRestart && profileTicks > 0) {
+			uint32_t gap = now - profileLastTick;
+			if (gap > period + period/2) {
+				profileSkipped += (gap + period/2) / period - 1;
+			}
+		}
+		profileLastTick = now;
+		profileTickRestart = false;
+	}
+
+	void KniwwelinoLib::_PROFILEadd(uint8_t stage, uint32_t cycles) {
+		if (profileCalls[stage] == 0 || cycles < profileMin[stage]) profileMin[stage] = cycles;
+		if (cycles > profileMax[stage]) profileMax[stage] = cycles;
+		profileTotal[stage] += cycles;
+		profileCalls[stage]++;
+	}
+
+	/*
+	 * Enables/disables the measurement of the time spent in the background tick.
+	 * Enabling resets all counters.
+	 * While enabled, the results are also published with the MQTT status (status/tick).
+	 */
+	void KniwwelinoLib::PROFILEenable(boolean on) {
+		if (on) PROFILEreset();
+		profileEnabled = on;
+	}
+
+	/*
+	 * Resets all profiling counters.
+	 */
+	void KniwwelinoLib::PROFILEreset() {
+		for (uint8_t i = 0; i < PROFILE_STAGES; i++) {
+			profileMin[i] = 0;
+			profileMax[i] = 0;
+			profileTotal[i] = 0;
+		}
+		for (uint8_t i = 0; i < PROFILE_STAGES; i++) {
+			profileCalls[i] = 0;
+		}
+		profileTicks = 0;
+		profileOverruns = 0;
+		profileSkipped = 0;
+	}
+
+	/*
+	 * Sets the time a tick may take before it is counted as overrun.
+	 * budgetMicros = time in micro seconds (default PROFILE_BUDGET_US)
+	 */
+	void KniwwelinoLib::PROFILEsetBudget(uint32_t budgetMicros) {
+		profileBudget = budgetMicros;
+	}
+
+	/*
+	 * returns the minimum/average/maximum CPU cycles spent in the given task per run.
+	 * stage = PROFILE_PINS/PROFILE_RGB/PROFILE_MATRIX/PROFILE_DISPLAY/PROFILE_BUTTONS,
+	 *         a user task id or PROFILE_TICK (whole tick)
+	 */
+	uint32_t KniwwelinoLib::PROFILEmin(uint8_t stage) {
+		if (stage >= PROFILE_STAGES) return 0;
+		return profileMin[stage];
+	}
+
+	uint32_t KniwwelinoLib::PROFILEavg(uint8_t stage) {
+		if (stage >= PROFILE_STAGES || profileCalls[stage] == 0) return 0;
+		return profileTotal[stage] / profileCalls[stage];
+	}
+
+	uint32_t KniwwelinoLib::PROFILEmax(uint8_t stage) {
+		if (stage >= PROFILE_STAGES) return 0;
+		return profileMax[stage];
+	}
+
+	/*
+	 * returns the number of measured ticks.
+	 */
+	uint32_t KniwwelinoLib::PROFILEticks() {
+		return profileTicks;
+	}
+
+	/*
+	 * returns the number of ticks that took longer than the budget.
+	 */
+	uint32_t KniwwelinoLib::PROFILEoverruns() {
+		return profileOverruns;
+	}
+
+	/*
+	 * returns the number of ticks that were not run in time by the ticker.
+	 */
+	uint32_t KniwwelinoLib::PROFILEskipped() {
+		return profileSkipped;
+	}
+
+	/*
+	 * returns all profiling results as one line of text.
+	 * times are min/avg/max in micro seconds.
+	 * tasks that never ran are left out.
+	 * e.g. "pins:1/1/2 rgb:2/3/40 matrix:5/40/700 display:150/160/200 buttons:310/320/500 tick:10/420/1200 ticks:1200 overruns:0 skipped:3"
+	 */
+	String KniwwelinoLib::PROFILEreport() {
+		static const char* const names[TASK_USER] = { "pins", "rgb", "matrix", "display", "buttons" };
+		uint32_t mhz = ESP.getCpuFreqMHz();
+		String report;
+		for (uint8_t i = 0; i < PROFILE_STAGES; i++) {
+			if (profileCalls[i] == 0) continue;
+			if (i < TASK_USER) {
+				report += names[i];
+			} else if (i == PROFILE_TICK) {
+				report += "tick";
+			} else {
+				report += "task";
+				report += i;
+			}
+			report += ':';
+			report += PROFILEmin(i) / mhz;
+			report += '/';
+			report += PROFILEavg(i) / mhz;
+			report += '/';
+			report += PROFILEmax(i) / mhz;
+			report += ' ';
+		}
+		report += "ticks:";
+		report += profileTicks;
+		report += " overruns:";
+		report += profileOverruns;
+		report += " skipped:";
+		report += profileSkipped;
+		return report;
 	}
 
 	//====  logging  =============================================================
@@ -428,66 +1190,250 @@ void KniwwelinoLib::setSilent() {
 	 * internal function for EXTERNAL PIN button or LED blink/flash effects
 	 */
 	void KniwwelinoLib::_PINhandle() {
-		pinBlinkCount++;
-		if (pinBlinkCount > 10) {
-			pinBlinkCount = 1;
-		}
-		
-		for (int i = 0; i < sizeof(ioPinNumers); i++) {
-			if (ioPinStatus[i] == PIN_UNUSED) {
+		// sleep until a pin gets a curve effect or button,
+		// on/off/blink/flash are done by PINsetEffect and the pin timers.
+		boolean idle = true;
+		for (uint8_t i = 0; i < PIN_COUNT; i++) {
+			if (ioPinStatus[i] != PIN_INPUT && ioPinStatus[i] <= PIN_ON) {
 				continue;
 			}
-
-			// read external Button
-			if (ioPinStatus[i] == PIN_INPUT) {
-				if (!digitalRead(ioPinNumers[i])) ioPinclicked[i] = true;
+			idle = false;
+
+			// curve effects, PWM 0-PIN_PWM_RANGE
+			if (ioPinStatus[i] > PIN_ON) {
+				if (i == tonePinIndex) continue;
+				uint8_t level;
+				_CURVEstep(ioPinStatus[i], ioPinPhase[i], level);
+				analogWrite(ioPinNumers[i], ((uint32_t) level * PIN_PWM_RANGE + 127) / 255);
 				continue;
 			}
 
-			// if Effect Time has passed, turn off Pin
-			if (ioPinStatus[i] == PIN_OFF) {
-				//DEBUG_PRINT("_PINblink ");DEBUG_PRINT(ioPinNumers[i]);DEBUG_PRINTLN(" LOW");
-				digitalWrite(ioPinNumers[i], LOW);
-				continue;
-			}
-			// if Effect is static on, nothing to do
-			if (ioPinStatus[i] == PIN_ON) {
-				//DEBUG_PRINT("_PINblink ");DEBUG_PRINT(ioPinNumers[i]);DEBUG_PRINTLN(" HIGH");
-				digitalWrite(ioPinNumers[i], HIGH);
-				continue;
-			}
-			// handle effect
-			if (pinBlinkCount <= ioPinStatus[i]) {
-				//DEBUG_PRINT("_PINblink ");DEBUG_PRINT(ioPinNumers[i]);DEBUG_PRINTLN(" HIGH");
-				digitalWrite(ioPinNumers[i], HIGH);
-			} else {
-				//DEBUG_PRINT("_PINblink ");DEBUG_PRINT(ioPinNumers[i]);DEBUG_PRINTLN(" LOW");
-				digitalWrite(ioPinNumers[i], LOW);
+			// read external Button
+			if (ioPinStatus[i] == PIN_INPUT) {
+				boolean down = !digitalRead(ioPinNumers[i]);
+				// GPIO16 (D0) has no interrupt, count its pulses here
+				if (ioPinCounter[i] && ioPinNumers[i] == 16 && down && !gestures[EVENT_PIN_D0 + i].raw) {
+					_PINpulse(i, micros());
+				}
+				_EVENTinput(EVENT_PIN_D0 + i, down, millis());
+				if (down) ioPinclicked[i] = true;
 			}
 		}
+		tasks[TASK_PINS].idle = idle;
 	}
 
 	/*
 	 * Set the specified I/O Pin of the board to on/off/blink/flash.
 	 * pin = D5/D6/D7
 	 * effect = RGB_ON/RGB_BLINK/RGB_FLASH/RGB_OFF
+	 *          or PIN_SPARK/PIN_GLOW/PIN_FADE_IN/PIN_FADE_OUT/PIN_CURVE (PWM, e.g. for LEDs)
 	 */
 	void KniwwelinoLib::PINsetEffect(uint8_t pin, int effect) {
-		switch (pin) {
-		    case D0:
-		      ioPinStatus[0] = effect;
-		      break;
-		    case D5:
-		      ioPinStatus[1] = effect;
-		      break;
-		    case D6:
-		      ioPinStatus[2] = effect;
-		      break;
-		    case D7:
-		      ioPinStatus[3] = effect;
-		      break;
-		    break;
-		  }
+		int8_t i = _PINindex(pin);
+		if (i < 0) return;
+
+		os_timer_disarm(&ioPinTimer[i]);
+		_PINstopCounter(i);
+		ioPinStatus[i] = effect;
+		ioPinPhase[i] = 0;
+		_PINapply(i);
+		_TASKwake(TASK_PINS);
+	}
+
+	/*
+	 * internal function that writes the pin or starts its timer for the current effect.
+	 * a pin used by a melody is left alone, the effect is applied when the melody ends.
+	 */
+	void KniwwelinoLib::_PINapply(uint8_t index) {
+		if (index == tonePinIndex) return;
+		int effect = ioPinStatus[index];
+		if (effect == PIN_ON || effect == PIN_OFF) {
+			// written once, no updates needed
+			digitalWrite(ioPinNumers[index], effect == PIN_ON ? HIGH : LOW);
+		} else if (effect > PIN_OFF && effect < PIN_ON) {
+			// blink/flash: on for effect * 50ms every 500ms
+			_PINstartTimer(index, effect * 50, (PIN_ON - effect) * 50);
+		} else if (effect == PIN_TIMED) {
+			_PINstartTimer(index, ioPinOnMs[index], ioPinOffMs[index]);
+		}
+	}
+
+	/*
+	 * Switches the specified I/O Pin on and off with the given frequency, timed
+	 * independently of the background tick.
+	 * the edges are set by SDK timers: 1ms resolution and some jitter, as they run
+	 * between loop() calls, not exact enough for servo or audio signals.
+	 * pin = D0/D5/D6/D7, needs to be set as OUTPUT.
+	 * frequency = switching frequency in Hz (max. 500)
+	 * duty = percentage of the time the pin is on (0-100)
+	 */
+	void KniwwelinoLib::PINsetFrequency(uint8_t pin, float frequency, uint8_t duty) {
+		int8_t i = _PINindex(pin);
+		if (i < 0) return;
+		if (frequency <= 0) {
+			PINsetEffect(pin, PIN_OFF);
+			return;
+		}
+
+		uint32_t period = constrain((uint32_t)(1000.0 / frequency + 0.5), 2, 3600000UL);
+		uint32_t on = (period * constrain(duty, 0, 100) + 50) / 100;
+		if (on == 0 && duty > 0) on = 1;
+		if (on == period && duty < 100) on = period - 1;
+
+		os_timer_disarm(&ioPinTimer[i]);
+		ioPinStatus[i] = PIN_TIMED;
+		ioPinOnMs[i] = on;
+		ioPinOffMs[i] = period - on;
+		_PINapply(i);
+		_TASKwake(TASK_PINS);
+	}
+
+	/*
+	 * Uses the specified I/O Pin as button (see PINenableButton) and counts its
+	 * pulses (falling edges) by interrupt, so short pulses are never missed.
+	 * e.g. for reed switches of flow or energy meters.
+	 * D0 has no interrupt, its pulses are counted every tick (50ms).
+	 *
+	 * pin = D0/D5/D6/D7
+	 * debounceMicros = edges within this time after a pulse are ignored (0 = off)
+	 */
+	void KniwwelinoLib::PINenableCounter(uint8_t pin) {
+		PINenableCounter(pin, 0);
+	}
+
+	void KniwwelinoLib::PINenableCounter(uint8_t pin, uint32_t debounceMicros) {
+		int8_t i = _PINindex(pin);
+		if (i < 0) return;
+		PINenableButton(pin);
+		ioPinDebounce[i] = debounceMicros;
+		PINresetPulseCount(pin);
+		ioPinCounter[i] = true;
+
+		if (pin == 16) return;
+		switch (i) {
+		case 1:
+			attachInterrupt(pin, _PINisr<1>, FALLING);
+			break;
+		case 2:
+			attachInterrupt(pin, _PINisr<2>, FALLING);
+			break;
+		case 3:
+			attachInterrupt(pin, _PINisr<3>, FALLING);
+			break;
+		}
+	}
+
+	/*
+	 * returns the number of pulses counted on the pin since PINenableCounter/PINresetPulseCount.
+	 */
+	uint32_t KniwwelinoLib::PINgetPulseCount(uint8_t pin) {
+		int8_t i = _PINindex(pin);
+		if (i < 0) return 0;
+		return ioPinPulses[i];
+	}
+
+	/*
+	 * returns the pulses per second on the pin, averaged over the last PIN_PULSE_BUFFER pulses.
+	 * goes down to 0 when the pulses stop.
+	 */
+	float KniwwelinoLib::PINgetPulseRate(uint8_t pin) {
+		int8_t i = _PINindex(pin);
+		if (i < 0) return 0;
+
+		noInterrupts();
+		uint32_t pulses = ioPinPulses[i];
+		uint8_t head = ioPinPulseHead[i];
+		uint8_t n = (pulses < PIN_PULSE_BUFFER) ? pulses : PIN_PULSE_BUFFER;
+		uint32_t last = ioPinPulseTimes[i][(head - 1) & (PIN_PULSE_BUFFER - 1)];
+		uint32_t first = ioPinPulseTimes[i][(head - n) & (PIN_PULSE_BUFFER - 1)];
+		interrupts();
+		if (n < 2) return 0;
+
+		float interval = (float)(last - first) / (n - 1);
+		uint32_t since = micros() - last;
+		if (since > interval) {
+			// slower now or stopped, count the running interval as well
+			interval = (float)(last - first + since) / n;
+		}
+		return 1000000.0 / interval;
+	}
+
+	/*
+	 * sets the pulse counter of the pin back to 0.
+	 */
+	void KniwwelinoLib::PINresetPulseCount(uint8_t pin) {
+		int8_t i = _PINindex(pin);
+		if (i < 0) return;
+		noInterrupts();
+		ioPinPulses[i] = 0;
+		ioPinPulseHead[i] = 0;
+		interrupts();
+	}
+
+	template<uint8_t I> void ICACHE_RAM_ATTR KniwwelinoLib::_PINisr() {
+		Kniwwelino._PINpulse(I, micros());
+	}
+
+	/*
+	 * internal function that records a pulse, called by the edge interrupt.
+	 */
+	void ICACHE_RAM_ATTR KniwwelinoLib::_PINpulse(uint8_t index, uint32_t time) {
+		uint8_t head = ioPinPulseHead[index];
+		if (ioPinPulses[index] > 0 &&
+				time - ioPinPulseTimes[index][(head - 1) & (PIN_PULSE_BUFFER - 1)] < ioPinDebounce[index]) {
+			return;
+		}
+		ioPinPulseTimes[index][head & (PIN_PULSE_BUFFER - 1)] = time;
+		ioPinPulseHead[index] = head + 1;
+		ioPinPulses[index]++;
+		// a pulse shorter than the tick still counts as click
+		ioPinclicked[index] = true;
+	}
+
+	void KniwwelinoLib::_PINstopCounter(uint8_t index) {
+		if (!ioPinCounter[index]) return;
+		ioPinCounter[index] = false;
+		if (ioPinNumers[index] != 16) detachInterrupt(ioPinNumers[index]);
+	}
+
+	/*
+	 * internal function that returns the index of a pin in ioPinNumers, -1 for other pins.
+	 */
+	int8_t KniwwelinoLib::_PINindex(uint8_t pin) {
+		for (uint8_t i = 0; i < PIN_COUNT; i++) {
+			if (ioPinNumers[i] == pin) return i;
+		}
+		return -1;
+	}
+
+	/*
+	 * internal function that starts switching a pin by its timer, on first.
+	 */
+	void KniwwelinoLib::_PINstartTimer(uint8_t index, uint32_t onMs, uint32_t offMs) {
+		uint8_t pin = ioPinNumers[index];
+		if (offMs == 0 || onMs == 0) {
+			// always on or off
+			digitalWrite(pin, onMs > 0 ? HIGH : LOW);
+			return;
+		}
+		// leave PWM/open states, the timer then only writes the registers
+		digitalWrite(pin, HIGH);
+		ioPinOnMs[index] = onMs;
+		ioPinOffMs[index] = offMs;
+		ioPinLevel[index] = true;
+		os_timer_arm(&ioPinTimer[index], onMs, false);
+	}
+
+	/*
+	 * internal timer function, switches the pin and arms the timer for the next edge.
+	 */
+	void KniwwelinoLib::_PINtimer(void* arg) {
+		uint8_t i = (uintptr_t) arg;
+		KniwwelinoLib &k = Kniwwelino;
+		boolean high = !k.ioPinLevel[i];
+		k.ioPinLevel[i] = high;
+		_pinWrite(k.ioPinNumers[i], high);
+		os_timer_arm(&k.ioPinTimer[i], high ? k.ioPinOnMs[i] : k.ioPinOffMs[i], false);
 	}
 
 	/*
@@ -496,6 +1442,13 @@ void KniwwelinoLib::setSilent() {
 	 * pin = D5/D6/D7
 	 */
 	void KniwwelinoLib::PINclear(uint8_t pin) {
+		// a melody on the pin ends first, else the write would cut it
+		if (tonePlaying && toneQueue[toneTail].pin == pin) TONEstop();
+		int8_t i = _PINindex(pin);
+		if (i >= 0) {
+			os_timer_disarm(&ioPinTimer[i]);
+			_PINstopCounter(i);
+		}
 	    digitalWrite(pin, LOW);
 		switch (pin) {
 		    case D0:
@@ -515,6 +1468,12 @@ void KniwwelinoLib::setSilent() {
 	}
 
 	void KniwwelinoLib::PINenableButton(uint8_t pin) {
+		if (tonePlaying && toneQueue[toneTail].pin == pin) TONEstop();
+		int8_t i = _PINindex(pin);
+		if (i >= 0) {
+			os_timer_disarm(&ioPinTimer[i]);
+			_PINstopCounter(i);
+		}
 		pinMode(pin, INPUT_PULLUP);
 		switch (pin) {
 		case D0:
@@ -530,6 +1489,7 @@ void KniwwelinoLib::setSilent() {
 			ioPinStatus[3] = PIN_INPUT;
 			break;
 		}
+		_TASKwake(TASK_PINS);
 	}
 
 	boolean KniwwelinoLib::PINbuttonClicked(uint8_t pin) {
@@ -562,6 +1522,167 @@ void KniwwelinoLib::setSilent() {
 		return !digitalRead(pin);
 	}
 
+//==== Analog input =========================================================
+
+	/*
+	 * Samples the analog input A0 in the background.
+	 * the samples are summarized in windows: min, max, mean and standard deviation.
+	 *
+	 * sampleRate = samples per second, timed by a ticker with 1ms resolution, so it has
+	 *              to divide 1000 (1, 2, 4, 5, 8, 10, 20, 25, 40, 50, 100, 125, 200, 250, 500, 1000)
+	 * windowSamples = samples per window, e.g. sampleRate for one window per second.
+	 *
+	 * returns false (and does not start) for other sample rates.
+	 */
+	boolean KniwwelinoLib::ADCstart(uint16_t sampleRate, uint16_t windowSamples) {
+		if (sampleRate == 0 || sampleRate > ADC_MAX_RATE || 1000 % sampleRate != 0) {
+			DEBUG_PRINTLN(F("ADCstart: sample rate has to divide 1000"));
+			return false;
+		}
+		adcTicker.detach();
+		adcWindowSamples = max(windowSamples, (uint16_t) 1);
+		adcCurrent.count = 0;
+		adcHead = 0;
+		adcTail = 0;
+		adcRead = 0;
+		adcHasData = false;
+		adcTicker.attach_ms(1000 / sampleRate, _ADCsample);
+		return true;
+	}
+
+	/*
+	 * Stops sampling A0.
+	 */
+	void KniwwelinoLib::ADCstop() {
+		adcTicker.detach();
+	}
+
+	/*
+	 * Publishes the finished windows of the A0 sampler via MQTT, several windows per message.
+	 * message format: min,max,mean,stddev for each window, windows separated by ';'
+	 * e.g. "12,530,240,88;10,610,251,93"
+	 *
+	 * topic = topic within the MQTT group, e.g. "LIGHT", nullptr stops publishing.
+	 * windowsPerMessage = windows sent in one message (1 - ADC_WINDOWS)
+	 */
+	void KniwwelinoLib::ADCpublish(const char topic[], uint8_t windowsPerMessage) {
+		if (topic == nullptr) {
+			adcPerMessage = 0;
+			return;
+		}
+		adcTopicName = topic;
+		_ADCupdatePublish();
+		adcTail = adcHead;
+		adcPerMessage = constrain(windowsPerMessage, 1, ADC_WINDOWS);
+	}
+
+	/*
+	 * returns the last sample of A0 (0-1023).
+	 */
+	uint16_t KniwwelinoLib::ADClast() {
+		return adcLast;
+	}
+
+	/*
+	 * returns true once for each finished window, ADCmin/max/mean/stddev then report it.
+	 */
+	boolean KniwwelinoLib::ADCwindowDone() {
+		uint8_t head = adcHead;
+		if (head == adcRead) return false;
+		adcRead = head;
+		return true;
+	}
+
+	/*
+	 * return the min/max/mean of the samples in the last finished window, 0 before the first one.
+	 * stddev is the standard deviation around the mean (the RMS of the AC part),
+	 * e.g. the sound level of a microphone.
+	 */
+	uint16_t KniwwelinoLib::ADCmin() {
+		if (!adcHasData) return 0;
+		return adcWindows[(adcHead - 1) & (ADC_WINDOWS - 1)].min;
+	}
+
+	uint16_t KniwwelinoLib::ADCmax() {
+		if (!adcHasData) return 0;
+		return adcWindows[(adcHead - 1) & (ADC_WINDOWS - 1)].max;
+	}
+
+	float KniwwelinoLib::ADCmean() {
+		if (!adcHasData) return 0;
+		const ADCWindow &w = adcWindows[(adcHead - 1) & (ADC_WINDOWS - 1)];
+		return (float) w.sum / w.count;
+	}
+
+	float KniwwelinoLib::ADCstddev() {
+		if (!adcHasData) return 0;
+		const ADCWindow &w = adcWindows[(adcHead - 1) & (ADC_WINDOWS - 1)];
+		float mean = (float) w.sum / w.count;
+		float variance = (float) w.sumSquares / w.count - mean * mean;
+		return variance > 0 ? sqrt(variance) : 0;
+	}
+
+	/*
+	 * internal ticker function that takes one sample of A0.
+	 * only sums up, mean/stddev are computed when read.
+	 */
+	void KniwwelinoLib::_ADCsample() {
+		KniwwelinoLib &k = Kniwwelino;
+		uint16_t v = analogRead(A0);
+		k.adcLast = v;
+
+		ADCWindow &w = k.adcCurrent;
+		if (w.count == 0) {
+			w.min = v;
+			w.max = v;
+			w.sum = 0;
+			w.sumSquares = 0;
+		}
+		if (v < w.min) w.min = v;
+		if (v > w.max) w.max = v;
+		w.sum += v;
+		w.sumSquares += (uint32_t) v * v;
+
+		if (++w.count >= k.adcWindowSamples) {
+			uint8_t head = k.adcHead;
+			// publishing too slow -> drop the oldest window
+			if ((uint8_t)(head - k.adcTail) >= ADC_WINDOWS) k.adcTail++;
+			k.adcWindows[head & (ADC_WINDOWS - 1)] = w;
+			k.adcHead = head + 1;
+			k.adcHasData = true;
+			w.count = 0;
+		}
+	}
+
+	/*
+	 * internal function that rebuilds the publish topic, e.g. after MQTTsetGroup().
+	 */
+	void KniwwelinoLib::_ADCupdatePublish() {
+		adcTopic = mqttGroup + adcTopicName;
+	}
+
+	/*
+	 * internal function that publishes the finished windows, called by loop()/sleep().
+	 * the message is built in a stack buffer, no Strings per window.
+	 */
+	void KniwwelinoLib::_ADCsend() {
+		if (adcPerMessage == 0 || !mqtt.connected()) return;
+		if ((uint8_t)(adcHead - adcTail) < adcPerMessage) return;
+
+		char payload[ADC_WINDOWS * 20 + 1];	// "1023,1023,1023,1023;" per window (min,max,mean,stddev)
+		size_t len = 0;
+		for (uint8_t i = 0; i < adcPerMessage; i++) {
+			const ADCWindow &w = adcWindows[adcTail & (ADC_WINDOWS - 1)];
+			adcTail++;
+			float mean = (float) w.sum / w.count;
+			float variance = (float) w.sumSquares / w.count - mean * mean;
+			uint16_t stddev = variance > 0 ? (uint16_t) (sqrt(variance) + 0.5) : 0;
+			len += snprintf(payload + len, sizeof(payload) - len, "%s%u,%u,%u,%u", i ? ";" : "",
+					w.min, w.max, (uint16_t) (mean + 0.5), stddev);
+		}
+		mqtt.publish(adcTopic.c_str(), payload);
+	}
+
 //==== RGB LED  functions ====================================================
 
 	/*
@@ -605,28 +1726,32 @@ void KniwwelinoLib::setSilent() {
 	}
 
 	void KniwwelinoLib::RGBsetColorEffect(String colorEffect) {
-		int pos = 0, lastpos = 0;
-		String color = "";
-		int effect = RGB_ON;
-		int duration = RGB_FOREVER;
+		RGBsetColorEffect(colorEffect.c_str());
+	}
 
-		pos = colorEffect.indexOf(":", pos);
-		if (pos == -1) {
-			RGBsetColor(colorEffect);
+	/*
+	 * Set the RGB LED of the board to show the given color and effect.
+	 * colorEffect = color[:effect[:count]], e.g. "FF0000:5:30" blinks red for 3 sec.
+	 * color = see RGBparseColor, effect and count as for RGBsetEffect.
+	 * invalid colors are ignored.
+	 */
+	void KniwwelinoLib::RGBsetColorEffect(const char colorEffect[]) {
+		const char* sep = strchr(colorEffect, ':');
+		uint16_t len = sep ? sep - colorEffect : strlen(colorEffect);
+		uint32_t color;
+		if (!RGBparseColor(colorEffect, len, color)) {
+			DEBUG_PRINTLN(F("RGBsetColorEffect: invalid color"));
 			return;
-		} else if (pos == 6) {
-			color = colorEffect.substring(0,6);
-			lastpos = pos+1;
-			pos = colorEffect.indexOf(":", lastpos);
-			if (pos != -1) {
-				effect = colorEffect.substring(lastpos,pos).toInt();
-				lastpos = pos+1;
-				if (colorEffect.length() >= lastpos) {
-					duration = colorEffect.substring(pos+1).toFloat();
-				}
-			}
 		}
-		RGBsetColorEffect(color, effect, duration);
+
+		int effect = RGB_ON;
+		int count = RGB_FOREVER;
+		if (sep) {
+			effect = atoi(sep + 1);
+			sep = strchr(sep + 1, ':');
+			if (sep) count = atoi(sep + 1);
+		}
+		RGBsetColorEffect(color, effect, count);
 	}
 
 	/*
@@ -652,7 +1777,7 @@ void KniwwelinoLib::setSilent() {
 		RGB.setPixelColor(0, red, green, blue);
 
 		if (rgbColor != RGB.getPixelColor(0)) {
-			RGB.show();
+			_RGBshow();
 		}
 		rgbColor = RGB.getPixelColor(0);
 	}
@@ -667,11 +1792,13 @@ void KniwwelinoLib::setSilent() {
 
 		rgbEffect = effect;
 		rgbEffectCount = count;
+		_TASKwake(TASK_RGB);
 
 		if (rgbEffect==RGB_ON) {
 			RGB.setPixelColor(0, rgbColor);
 			changed = true;
 		} else if (rgbEffect > 10) {
+			rgbEffectPhase = 0;
 			changed = true;
 		}
 
@@ -687,7 +1814,7 @@ void KniwwelinoLib::setSilent() {
 		rgbEffectCount=0;
 		if (rgbColor!=0) {
 			RGB.setPixelColor(0, 0);
-			RGB.show();
+			_RGBshow();
 		}
 		rgbColor = 0;
 	}
@@ -700,7 +1827,7 @@ void KniwwelinoLib::setSilent() {
 		b = constrain(b, 1, 255);
 		rgbBrightness = b;
 		RGB.setBrightness(b);
-		RGB.show();
+		_RGBshow();
 	}
 
 	/*
@@ -710,6 +1837,145 @@ void KniwwelinoLib::setSilent() {
 		return rgbColor;
 	}
 
+	/*
+	 * Plays a sequence of colors on the RGB LED in the background.
+	 * keyframes are separated by ';' or new lines: color[:ticks[:f]]
+	 *   color = color like FF0000, #ff0000, red or hsv(0,100,100), see RGBparseColor
+	 *   ticks = how long the keyframe lasts, 20 ticks = 1sec (default 20)
+	 *   f = fade to the color of the next keyframe, else the color is held.
+	 * e.g. "FF0000:20:f;00FF00:20:f;0000FF:20:f" for a rainbow.
+	 *
+	 * loops = how often the sequence is played (-1 = forever)
+	 *
+	 * returns false if the sequence is invalid, the LED is not changed then.
+	 */
+	boolean KniwwelinoLib::RGBplaySequence(const char sequence[], int loops) {
+		RGBKey keys[RGB_SEQ_MAX_KEYS];
+		uint8_t count = 0;
+		const char* c = sequence;
+
+		while (*c != 0) {
+			if (*c == ';' || *c == '\n' || *c == '\r' || *c == ' ') {
+				c++;
+				continue;
+			}
+			if (count >= RGB_SEQ_MAX_KEYS) return false;
+			RGBKey &k = keys[count++];
+
+			// color
+			uint16_t len = strcspn(c, ":;\r\n");
+			if (!RGBparseColor(c, len, k.color)) return false;
+			c += len;
+			k.ticks = 20;
+			k.fade = false;
+
+			// duration
+			if (*c == ':') {
+				c++;
+				if (*c < '0' || *c > '9') return false;
+				uint32_t ticks = 0;
+				while (*c >= '0' && *c <= '9') ticks = ticks * 10 + (*c++ - '0');
+				k.ticks = constrain(ticks, 1, 65535);
+			}
+			// interpolation
+			if (*c == ':') {
+				c++;
+				if (*c == 'f' || *c == 'F') {
+					k.fade = true;
+					c++;
+				} else if (*c == 'h' || *c == 'H') {
+					c++;
+				}
+			}
+			if (*c != 0 && *c != ';' && *c != '\n' && *c != '\r' && *c != ' ') return false;
+		}
+		if (count == 0) return false;
+
+		// stop the running sequence before changing its keys
+		rgbEffect = RGB_OFF;
+		memcpy(rgbSeq, keys, count * sizeof(RGBKey));
+		rgbSeqLen = count;
+		rgbSeqPos = 0;
+		rgbSeqTick = 0;
+		RGBsetEffect(RGB_SEQUENCE, (loops == 0) ? 1 : loops);
+		return true;
+	}
+
+	boolean KniwwelinoLib::RGBplaySequence(String sequence, int loops) {
+		return RGBplaySequence(sequence.c_str(), loops);
+	}
+
+	/*
+	 * Loads a color sequence from a file in the internal flash memory and plays it.
+	 * same format as RGBplaySequence, one keyframe per line.
+	 */
+	boolean KniwwelinoLib::RGBplaySequenceFile(String fileName, int loops) {
+		String content = FILEread(fileName);
+		return RGBplaySequence(content.c_str(), loops);
+	}
+
+	/*
+	 * internal function that plays one tick of the color sequence.
+	 * fades are done in 8.8 fixed point, the steps are computed once per keyframe.
+	 */
+	void KniwwelinoLib::_RGBsequence() {
+		RGBKey &k = rgbSeq[rgbSeqPos];
+		if (rgbSeqTick == 0) {
+			// keyframe starts
+			const RGBKey &next = rgbSeq[(rgbSeqPos + 1) % rgbSeqLen];
+			for (uint8_t i = 0; i < 3; i++) {
+				uint8_t shift = 16 - i * 8;
+				int32_t from = (k.color >> shift) & 0xFF;
+				int32_t to = (next.color >> shift) & 0xFF;
+				rgbSeqLevel[i] = from << 8;
+				rgbSeqDelta[i] = k.fade ? ((to - from) * 256) / k.ticks : 0;
+			}
+		}
+
+		RGB.setPixelColor(0, rgbSeqLevel[0] >> 8, rgbSeqLevel[1] >> 8, rgbSeqLevel[2] >> 8);
+		_RGBshow();
+		for (uint8_t i = 0; i < 3; i++) rgbSeqLevel[i] += rgbSeqDelta[i];
+
+		if (++rgbSeqTick >= k.ticks) {
+			rgbSeqTick = 0;
+			if (++rgbSeqPos >= rgbSeqLen) {
+				rgbSeqPos = 0;
+				if (rgbEffectCount > 0) rgbEffectCount--;
+			}
+		}
+	}
+
+	/*
+	 * returns how often the LED color was sent to the LED.
+	 */
+	uint32_t KniwwelinoLib::RGBshowCount() {
+		return rgbShows;
+	}
+
+	/*
+	 * returns how often sending the LED color was skipped because it did not change.
+	 */
+	uint32_t KniwwelinoLib::RGBshowSkipped() {
+		return rgbShowsSkipped;
+	}
+
+	/*
+	 * internal function that sends the color to the LED if it differs from what the LED shows.
+	 * show() blocks the interrupts for ~30us, which disturbs WiFi and tone().
+	 */
+	void KniwwelinoLib::_RGBshow() {
+		// compare the brightness scaled bytes, these are what goes over the wire
+		const uint8_t* pixels = RGB.getPixels();
+		if (rgbLatchedValid && memcmp(pixels, rgbLatched, sizeof(rgbLatched)) == 0) {
+			rgbShowsSkipped++;
+			return;
+		}
+		memcpy(rgbLatched, pixels, sizeof(rgbLatched));
+		rgbLatchedValid = true;
+		RGB.show();
+		rgbShows++;
+	}
+
 	/*
 	 * Internal ticker function to handle the LED effects.
 	 */
@@ -717,8 +1983,13 @@ void KniwwelinoLib::setSilent() {
 		// if Effect Time has passed, turn off LED
 		if (rgbEffectCount==0) {
 			Kniwwelino.RGBclear();
+			// sleep until the next RGBsetEffect()
+			tasks[TASK_RGB].idle = true;
+		} else if (rgbEffect == RGB_SEQUENCE) {
+			_RGBsequence();
 		} else if (rgbEffect == RGB_ON) {
 			// if Effect is static on, nothing to do
+			if (rgbEffectCount < 0) tasks[TASK_RGB].idle = true;
 			rgbBlinkCount++;
 			if (rgbBlinkCount > 10) {
 				rgbBlinkCount = 1;
@@ -730,11 +2001,11 @@ void KniwwelinoLib::setSilent() {
 				// handle effect
 				if (RGB.getPixelColor(0)==0) {
 					RGB.setPixelColor(0, rgbColor);
-					RGB.show();
+					_RGBshow();
 				}
 			} else {
 				RGB.setPixelColor(0, 0);
-				RGB.show();
+				_RGBshow();
 			}
 			rgbBlinkCount++;
 			if (rgbBlinkCount > 10) {
@@ -742,37 +2013,16 @@ void KniwwelinoLib::setSilent() {
 				if (rgbEffectCount > 0) rgbEffectCount--;
 			}
 		} else if (rgbEffect > 10) {
-			// other brightness effects
-			if (rgbEffect == RGB_SPARK) {
-				RGB.setPixelColor(0, rgbColor);
-				RGB.setBrightness(rgbEffectBrightness);
-				RGB.show();
-				rgbEffectBrightness /=2;
-				if (rgbEffectBrightness <= 0) {
-					rgbEffectBrightness = rgbBrightness;
-					if (rgbEffectCount > 0) rgbEffectCount--;
-				}
-			} else if (rgbEffect == RGB_GLOW) {
-				RGB.setPixelColor(0, rgbColor);
-				RGB.setBrightness(rgbEffectBrightness/10);
-				RGB.show();
-				if (rgbEffectModifier>0) {
-					rgbEffectBrightness *= 1.2;
-				} else {
-					rgbEffectBrightness /= 1.2;
-				}
-				if (rgbEffectBrightness <= 10) {
-					rgbEffectBrightness = 10;
-					rgbEffectModifier = 1;
-				} else if (rgbEffectBrightness >= (rgbBrightness*10)) {
-					rgbEffectModifier = -1;
-					if (rgbEffectCount > 0) rgbEffectCount--;
-				}
-			}
-
+			// brightness curve effects, scaled by the brightness of the LED.
+			// brightness first, so the color is scaled only once.
+			uint8_t level;
+			if (_CURVEstep(rgbEffect, rgbEffectPhase, level) && rgbEffectCount > 0) rgbEffectCount--;
+			RGB.setBrightness(((uint16_t) rgbBrightness * level) >> 8);
+			RGB.setPixelColor(0, rgbColor);
+			_RGBshow();
 		} else {
 			RGB.setPixelColor(0, 0);
-			RGB.show();
+			_RGBshow();
 		}
 	}
 
@@ -781,21 +2031,113 @@ void KniwwelinoLib::setSilent() {
 	 * to a 32bit int color.
 	 */
 	unsigned long KniwwelinoLib::RGBhex2int(String str) {
-	   int i;
-	   unsigned long val = 0;
-	   int len = str.length();
-
-	   // parse the first 6 chars for HEX
-	   if (len > 6) len = 6;
-
-	   for(i=0;i<len;i++) {
-		  char c = str.charAt(i);
-	      if(c <= 57)
-	       val += (c-48)*(1<<(4*(len-1-i)));
-	      else
-	       val += (c-55)*(1<<(4*(len-1-i)));
-	   }
-	   return val;
+		uint32_t color;
+		if (RGBparseColor(str.c_str(), str.length(), color)) return color;
+
+		// parse the first 6 chars for HEX
+		color = 0;
+		for (uint8_t i = 0; i < 6 && i < str.length(); i++) {
+			int8_t d = _hexDigit(str.charAt(i));
+			if (d < 0) break;
+			color = (color << 4) | d;
+		}
+		return color;
+	}
+
+	/*
+	 * Parses a color without creating Strings.
+	 * str = "#rrggbb", "rrggbb" (upper or lower case), "hsv(h,s,v)" with h 0-360, s and v 0-100
+	 *       or a name: off, black, white, red, green, blue, yellow, cyan, magenta, orange, purple, pink
+	 * len = number of characters to parse
+	 * color = the parsed color, unchanged if str is invalid.
+	 *
+	 * returns false if str is no valid color.
+	 */
+	boolean KniwwelinoLib::RGBparseColor(const char str[], uint32_t& color) {
+		return RGBparseColor(str, strlen(str), color);
+	}
+
+	boolean KniwwelinoLib::RGBparseColor(const char str[], uint16_t len, uint32_t& color) {
+		while (len > 0 && *str == ' ') { str++; len--; }
+		while (len > 0 && str[len-1] == ' ') len--;
+		if (len == 0) return false;
+
+		// hex
+		const char* hex = (str[0] == '#') ? str + 1 : str;
+		if (len - (hex - str) == 6) {
+			uint32_t c = 0;
+			uint8_t i = 0;
+			for (; i < 6; i++) {
+				int8_t d = _hexDigit(hex[i]);
+				if (d < 0) break;
+				c = (c << 4) | d;
+			}
+			if (i == 6) {
+				color = c;
+				return true;
+			}
+			if (hex != str) return false;
+		}
+
+		// hsv(h,s,v)
+		if (len > 5 && strncasecmp(str, "hsv(", 4) == 0 && str[len-1] == ')') {
+			int32_t v[3];
+			uint16_t pos = 4;
+			for (uint8_t i = 0; i < 3; i++) {
+				while (pos < len && str[pos] == ' ') pos++;
+				uint16_t n = _parseInt(str + pos, len - pos, v[i]);
+				if (n == 0) return false;
+				pos += n;
+				while (pos < len && str[pos] == ' ') pos++;
+				if (pos >= len || str[pos] != (i < 2 ? ',' : ')')) return false;
+				pos++;
+			}
+			if (pos != len || v[0] > 360 || v[1] > 100 || v[2] > 100) return false;
+
+			// integer HSV -> RGB, 6 sectors of 60 degrees
+			uint32_t value = v[2] * 255 / 100;
+			uint32_t sat = v[1] * 255 / 100;
+			uint32_t sector = (v[0] % 360) / 60;
+			uint32_t frac = ((v[0] % 360) - sector * 60) * 255 / 60;
+			uint32_t p = value * (255 - sat) / 255;
+			uint32_t q = value * (255 - sat * frac / 255) / 255;
+			uint32_t t = value * (255 - sat * (255 - frac) / 255) / 255;
+			uint32_t r, g, b;
+			switch (sector) {
+			case 0:  r = value; g = t; b = p; break;
+			case 1:  r = q; g = value; b = p; break;
+			case 2:  r = p; g = value; b = t; break;
+			case 3:  r = p; g = q; b = value; break;
+			case 4:  r = t; g = p; b = value; break;
+			default: r = value; g = p; b = q; break;
+			}
+			color = (r << 16) | (g << 8) | b;
+			return true;
+		}
+
+		// names
+		for (uint8_t i = 0; i < sizeof(_colorNames) / sizeof(_colorNames[0]); i++) {
+			if (len == strlen_P(_colorNames[i].name) && strncasecmp_P(str, _colorNames[i].name, len) == 0) {
+				color = pgm_read_dword(&_colorNames[i].color);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/*
+	 * Writes a color as "RRGGBB" into buffer, without creating Strings.
+	 * buffer = at least RGB_HEX_LEN chars.
+	 * returns buffer.
+	 */
+	char* KniwwelinoLib::RGBformatColor(uint32_t color, char buffer[RGB_HEX_LEN]) {
+		static const char digits[] = "0123456789ABCDEF";
+		for (int8_t i = 5; i >= 0; i--) {
+			buffer[i] = digits[color & 0xF];
+			color >>= 4;
+		}
+		buffer[6] = 0;
+		return buffer;
 	}
 	
 	/*
@@ -805,26 +2147,17 @@ void KniwwelinoLib::setSilent() {
      * Inspired by the Adafruit examples and WS2812FX lib.
 	 */
 	unsigned long KniwwelinoLib::RGBhue2int(uint8_t hue) {
-	  hue = 255 - hue;
-	  if(hue < 85) {
-	    return ((uint32_t)(255 - hue * 3) << 16) | ((uint32_t)(0) << 8) | (hue * 3);
-	  } else if(hue < 170) {
-	    hue -= 85;
-	    return ((uint32_t)(0) << 16) | ((uint32_t)(hue * 3) << 8) | (255 - hue * 3);
-	  } else {
-	    hue -= 170;
-	    return ((uint32_t)(hue * 3) << 16) | ((uint32_t)(255 - hue * 3) << 8) | (0);
-	  }
+		return pgm_read_dword(&_hueTable[hue]);
 	}
 
 	String KniwwelinoLib::RGB82Hex(uint8_t c) {
-		String s =  String(String(c<16?"0":"") + String(c, HEX));
-		s.toUpperCase();
-		return s;
+		char buffer[RGB_HEX_LEN];
+		return String(RGBformatColor(c, buffer) + 4);
 	}
 
 	String KniwwelinoLib::RGBcolor2Hex(unsigned long color) {
-		return String(RGB82Hex((uint8_t)(color >> 16)) + RGB82Hex((uint8_t)(color >>  8)) + RGB82Hex((uint8_t)color));
+		char buffer[RGB_HEX_LEN];
+		return String(RGBformatColor(color, buffer));
 	}
 	
 	String KniwwelinoLib::RGBhue2Hex(uint8_t hue) {
@@ -832,7 +2165,7 @@ void KniwwelinoLib::setSilent() {
 	}
 
 	String KniwwelinoLib::RGBcolor2Hex(uint8_t r, uint8_t g, uint8_t b) {
-	  return String(RGB82Hex(r) + RGB82Hex(g) + RGB82Hex(b));
+	  return RGBcolor2Hex(((uint32_t)r << 16) | ((uint32_t)g << 8) | b);
 	}
 
 
@@ -852,11 +2185,19 @@ void KniwwelinoLib::setSilent() {
     		Kniwwelino.MATRIXclear();
     	}
     	// if wait or different Text, reset position, else keep scrolling.
-    	if (wait || text != matrixText) {
+    	// text is scrolled by the ticker, an open frame/animation is dropped.
+    	matrixDrawBuffer = displaybuffer;
+    	matrixAnim = nullptr;
+    	boolean changed = (text != matrixText);
+    	if (wait || changed) {
         	matrixPos = 4;
     	}
     	matrixText = text;
+    	if (changed) {
+    		_MATRIXrenderText();
+    	}
     	matrixCount = count;
+    	_TASKwake(TASK_MATRIX);
     	if (wait) {
     		if (matrixText.length() == 1) {
     			Kniwwelino.sleep(1000);
@@ -902,94 +2243,314 @@ void KniwwelinoLib::setSilent() {
 	 * Icon is given as string and accepted in the following formats:
 	 * "B1111100000111110000011111" 25 pixels binary one after the other, prefix B
 	 * "0x7008E828A0" one byte for each 5px row, prefix 0x
+	 * both can be followed by ":effect:duration" (MATRIX_BLINK_ effect, duration in sec, -1 forever)
+	 * only the first line is used, see MATRIXplayIcons to play several icons.
 	 *
 	 * iconString = icon to be shown.
 	 */
     void KniwwelinoLib::MATRIXdrawIcon(String iconString) {
-		MATRIXclear();
-    	matrixText = "";
+    	MATRIXdrawIcon(iconString.c_str(), iconString.length());
+    }
+
+    void KniwwelinoLib::MATRIXdrawIcon(const char iconString[]) {
+    	MATRIXdrawIcon(iconString, strlen(iconString));
+    }
+
+	/*
+	 * Draw the given icon on the matrix. see above.
+	 *
+	 * iconString = icon to be shown, does not need to be null terminated.
+	 * len = length of iconString
+	 */
+    void KniwwelinoLib::MATRIXdrawIcon(const char iconString[], uint16_t len) {
+    	uint32_t bits;
+    	int32_t fields[2];
+    	uint8_t fieldCount;
+
+    	uint16_t pos = 0;
+    	while (pos < len && (iconString[pos] == '\n' || iconString[pos] == '\r' || iconString[pos] == ' ')) pos++;
+    	if (pos == len) {
+    		MATRIXclear();
+    		return;
+    	}
+
+    	// nothing is changed on invalid input.
+    	if (_MATRIXparseIcon(iconString + pos, len - pos, bits, fields, fieldCount) == 0) {
+    		DEBUG_PRINTLN(F("MATRIXdrawIcon: invalid icon string"));
+    		return;
+    	}
+
+    	MATRIXsetBlinkRate(fieldCount > 0 ? fields[0] / 10 : MATRIX_STATIC);
+    	MATRIXblit(bits);
+    	// duration in 1/10 sec
+    	if (fieldCount > 1) {
+    		matrixCount = fields[1];
+    		_TASKwake(TASK_MATRIX);
+    	}
+    }
+
+	/*
+	 * Plays several icons as animation in the background.
+	 * one icon per line in the MATRIXdrawIcon format, each is shown for its duration
+	 * (default 1 sec), the effect of the first icon is used for all.
+	 * e.g. "B1111100000111110000011111:0:0.5\nB0000011111000001111100000:0:0.5"
+	 *
+	 * iconString = icons to be shown.
+	 * loops = how often the animation is played (-1 = forever)
+	 *
+	 * returns false if the string contains no valid icon.
+	 */
+    boolean KniwwelinoLib::MATRIXplayIcons(String iconString, int loops) {
+    	uint8_t count = _MATRIXloadFrames(iconString.c_str(), iconString.length());
+    	if (count == 0) return false;
+    	MATRIXplayAnimation(matrixAnimFrames, count, loops);
+    	return true;
+    }
+
+	/*
+	 * internal function that parses icons, one per line, into matrixAnimFrames.
+	 * format as for MATRIXplayIcons, the effect of the first icon is set for the whole animation.
+	 * invalid lines are skipped.
+	 *
+	 * returns the number of frames.
+	 */
+    uint8_t KniwwelinoLib::_MATRIXloadFrames(const char* s, uint16_t len) {
+    	uint32_t bits;
+    	int32_t fields[2];
+    	uint8_t fieldCount;
+    	uint8_t count = 0;
+    	uint16_t pos = 0;
+    	// the RAM frame table might be in use
+    	matrixAnim = nullptr;
+    	while (pos < len && count < MATRIX_ANIM_MAX_FRAMES) {
+    		if (s[pos] == '\n' || s[pos] == '\r' || s[pos] == ' ') {
+    			pos++;
+    			continue;
+    		}
+    		uint16_t n = _MATRIXparseIcon(s + pos, len - pos, bits, fields, fieldCount);
+    		if (n == 0) {
+    			DEBUG_PRINTLN(F("MATRIX: invalid frame"));
+    			while (pos < len && s[pos] != '\n') pos++;
+    			continue;
+    		}
+    		pos += n;
+    		if (count == 0) MATRIXsetBlinkRate(fieldCount > 0 ? fields[0] / 10 : MATRIX_STATIC);
+    		// duration in sec (1/10 units), 2 ticks per 1/10
+    		int32_t ticks = (fieldCount > 1) ? fields[1] * 2 : 20;
+    		matrixAnimFrames[count++] = MATRIX_FRAME(bits, constrain(ticks, 1, 127));
+    	}
+    	return count;
+    }
+
+	/*
+	 * Draw the given icon on the matrix.
+	 * Icon is given as 32bit long.
+	 * bits correspond to the pixels starting at top left.
+	 *
+	 * iconLong = icon to be shown.
+	 */
+    void KniwwelinoLib::MATRIXdrawIcon(uint32_t iconLong) {
+			MATRIXsetBlinkRate(MATRIX_STATIC);
+			MATRIXblit(iconLong);
+    }
+
+	/*
+	 * Replaces the whole matrix content in one pass.
+	 * bits correspond to the pixels starting at top left (bit 24), like the ICON_ constants.
+	 *
+	 * bits = pixels to be shown.
+	 */
+    void KniwwelinoLib::MATRIXblit(uint32_t bits) {
+    	matrixAnim = nullptr;
+    	if (matrixText.length() > 0) matrixText = "";
     	matrixCount = -1;
-		MATRIXsetBlinkRate(MATRIX_STATIC);
+    	_MATRIXblit(matrixDrawBuffer, bits);
+    }
 
-    	if (iconString.startsWith("B") || iconString.startsWith("b")) {
-    		int pos = 0, lastpos = 0;
-    		// count icons
-    		iconcount = 1;
-    		if (iconString.indexOf("\n") <= 0) {
-				while (pos != -1 && lastpos < iconString.length()) {
-					pos = iconString.indexOf("\n",lastpos);
-					if (pos != -1) {
-						iconcount++;
-						lastpos = pos+1;
-					}
-				}
+	/*
+	 * Replaces the whole matrix content in one pass.
+	 * one byte for each 5px row, pixels in the 5 upper bits like the "0x" icon format.
+	 *
+	 * rows = 5 rows to be shown.
+	 */
+    void KniwwelinoLib::MATRIXblitRows(const uint8_t rows[5]) {
+    	uint32_t bits = 0;
+    	for (uint8_t y = 0; y < 5; y++) {
+    		bits = (bits << 5) | ((rows[y] >> 3) & 0x1F);
+    	}
+    	MATRIXblit(bits);
+    }
+
+	/*
+	 * Starts a new frame. Until MATRIXcommitFrame() is called, all drawing
+	 * (MATRIXsetPixel, MATRIXblit, MATRIXclear, ...) goes to a back buffer
+	 * and the matrix keeps showing the last complete frame.
+	 * The back buffer starts with the content currently shown.
+	 */
+    void KniwwelinoLib::MATRIXbeginFrame() {
+    	matrixAnim = nullptr;
+    	if (matrixText.length() > 0) matrixText = "";
+    	matrixCount = -1;
+    	memcpy(matrixBackBuffer, displaybuffer, sizeof(matrixBackBuffer));
+    	matrixDrawBuffer = matrixBackBuffer;
+    }
+
+	/*
+	 * Shows the frame drawn since MATRIXbeginFrame() as a whole.
+	 */
+    void KniwwelinoLib::MATRIXcommitFrame() {
+    	if (matrixDrawBuffer == displaybuffer) return;
+    	// the ticker never interrupts this, it runs between loop() calls
+    	memcpy(displaybuffer, matrixBackBuffer, sizeof(displaybuffer));
+    	matrixDrawBuffer = displaybuffer;
+    	redrawMatrix = true;
+    	_TICKwake();
+    }
+
+	/*
+	 * Plays an animation on the matrix in the background.
+	 *
+	 * frames = array of frames in PROGMEM, each built with MATRIX_FRAME(icon, ticks)
+	 *          e.g. const uint32_t anim[] PROGMEM = { MATRIX_FRAME(ICON_SMILE, 10), MATRIX_FRAME(ICON_SAD, 10) };
+	 * count = number of frames
+	 * loops = how often the animation is played (-1 = forever)
+	 *
+	 * the array must stay valid while the animation is playing.
+	 */
+    void KniwwelinoLib::MATRIXplayAnimation(const uint32_t* frames, uint8_t count, int loops) {
+    	matrixAnim = nullptr;
+    	if (count == 0) return;
+    	if (matrixText.length() > 0) matrixText = "";
+    	matrixCount = -1;
+    	matrixDrawBuffer = displaybuffer;
+    	matrixAnimProgmem = (frames != matrixAnimFrames);
+    	matrixAnimLen = count;
+    	matrixAnimPos = 0;
+    	matrixAnimWait = 0;
+    	matrixAnimLoops = (loops == 0) ? 1 : loops;
+    	matrixAnim = frames;
+    	_TASKwake(TASK_MATRIX);
+    }
+
+	/*
+	 * Loads an animation from a file in the internal flash memory and plays it in the background.
+	 * one frame per line, same format as for MATRIXplayIcons:
+	 * "B1111100000111110000011111:0:0.5" or "0x7008E828A0:0:0.5" (effect:duration in sec)
+	 *
+	 * fileName = file to load, should start with /
+	 * loops = how often the animation is played (-1 = forever)
+	 *
+	 * returns false if the file contains no valid frame.
+	 */
+    boolean KniwwelinoLib::MATRIXplayAnimationFile(String fileName, int loops) {
+    	String content = FILEread(fileName);
+    	uint8_t count = _MATRIXloadFrames(content.c_str(), content.length());
+    	if (count == 0) return false;
+    	MATRIXplayAnimation(matrixAnimFrames, count, loops);
+    	return true;
+    }
+
+	/*
+	 * Stops a running animation, the current frame stays on the matrix.
+	 */
+    void KniwwelinoLib::MATRIXstopAnimation() {
+    	matrixAnim = nullptr;
+    }
+
+	/*
+	 * returns true if no animation is playing (anymore).
+	 */
+    boolean KniwwelinoLib::MATRIXanimationDone() {
+    	return (matrixAnim == nullptr);
+    }
+
+	/*
+	 * internal parser for one icon in the MATRIXdrawIcon formats
+	 * "B1111100000111110000011111" or "0x7008E828A0", each followed by up to
+	 * two ":number" fields, which are returned in 1/10 units.
+	 * stops at the end of the string or at a newline.
+	 *
+	 * returns the number of characters used, 0 if the icon is invalid.
+	 */
+    uint16_t KniwwelinoLib::_MATRIXparseIcon(const char* s, uint16_t len, uint32_t &bits, int32_t fields[2], uint8_t &fieldCount) {
+    	uint16_t pos;
+    	bits = 0;
+    	fieldCount = 0;
+    	if (len >= 26 && (s[0] == 'B' || s[0] == 'b')) {
+    		for (pos = 1; pos < 26; pos++) {
+    			if (s[pos] != '0' && s[pos] != '1') return 0;
+    			bits = (bits << 1) | (s[pos] - '0');
     		}
+    	} else if (len >= 12 && s[0] == '0' && s[1] == 'x') {
+    		for (pos = 2; pos < 12; pos += 2) {
+    			int8_t hi = _hexDigit(s[pos]);
+    			int8_t lo = _hexDigit(s[pos+1]);
+    			if (hi < 0 || lo < 0) return 0;
+    			bits = (bits << 5) | (hi << 1) | (lo >> 3);
+    		}
+    	} else {
+    		return 0;
+    	}
+
+    	while (pos < len && s[pos] == ':' && fieldCount < 2) {
+    		uint16_t n = _parseTenths(s + pos + 1, len - pos - 1, fields[fieldCount]);
+    		if (n == 0) return 0;
+    		fieldCount++;
+    		pos += n + 1;
+    	}
+    	if (pos < len && s[pos] != '\n' && s[pos] != '\r' && s[pos] != ' ') return 0;
+    	return pos;
+    }
 
-    		// String must be like "B1111100000111110000011111" 25 pixels one after the other
-    		if (iconString.length() >25) {
-				for(int i=0; i < 25; i++) {
-					if (iconString.charAt(i+1) != '0') {
-						drawPixel(i%5, i/5, 1);
-					}
-				}
+	/*
+	 * internal function that steps the animation, called by the ticker.
+	 */
+    void KniwwelinoLib::_MATRIXanimate() {
+    	// show the current frame for its duration
+    	if (matrixAnimWait > 0) {
+    		matrixAnimWait--;
+    		if (matrixAnimWait > 0) return;
+    	}
 
-				if (iconString.length()>26) {
-					pos = 0;
-					lastpos = 0;
-					pos = iconString.indexOf(":", lastpos);
-					if (pos >= 26) {
-						lastpos = pos+1;
-						pos = iconString.indexOf(":", lastpos);
-						int effect = iconString.substring(lastpos,pos).toInt();
-						MATRIXsetBlinkRate(effect);
-						lastpos = pos+1;
-
-						if (iconString.length() >= lastpos) {
-							pos = iconString.indexOf("\n", lastpos);
-							float duration = iconString.substring(lastpos, pos).toFloat();
-							matrixCount = duration*10;
-						}
-					}
-				}
-    		} else {
-    			DEBUG_PRINTLN(F("MATRIXdrawIcon:Binay: Wrong String length (not 26)"));
-    			return;
-    		}
-    		redrawMatrix = true;
-    	} else if (iconString.startsWith("0x")) {
-    		// String must be like "0x7008E828A0" one byte for each 5px row
-    		if (iconString.length() != 12) {
-    			DEBUG_PRINTLN(F("MATRIXdrawIcon:Hex: Wrong String length (not 12)"));
+    	if (matrixAnimPos >= matrixAnimLen) {
+    		matrixAnimPos = 0;
+    		if (matrixAnimLoops > 0) matrixAnimLoops--;
+    		if (matrixAnimLoops == 0) {
+    			// done, last frame stays
+    			matrixAnim = nullptr;
     			return;
-    		} else {
-    		}
-    		for(int i=0; i < 5; i++) {
-    			String sub = iconString.substring((i*2)+2,(i*2)+4);
-    			int number = (int) strtol( &sub[0], NULL, 16);
-    			for(int j=0; j < 5; j++) {
-    				MATRIXsetPixel(j, i, bitRead(number, 7-j));
-    			}
     		}
-    		redrawMatrix = true;
     	}
+
+    	uint32_t frame;
+    	if (matrixAnimProgmem) {
+    		frame = pgm_read_dword(matrixAnim + matrixAnimPos);
+    	} else {
+    		frame = matrixAnim[matrixAnimPos];
+    	}
+    	_MATRIXblit(displaybuffer, frame & 0x1FFFFFF);
+    	matrixAnimWait = frame >> 25;
+    	if (matrixAnimWait == 0) matrixAnimWait = 1;
+    	matrixAnimPos++;
     }
 
 	/*
-	 * Draw the given icon on the matrix.
-	 * Icon is given as 32bit long.
-	 * bits correspond to the pixels starting at top left.
-	 *
-	 * iconLong = icon to be shown.
+	 * internal function that writes the given 25 pixels to the given buffer.
 	 */
-    void KniwwelinoLib::MATRIXdrawIcon(uint32_t iconLong) {
-			MATRIXsetBlinkRate(MATRIX_STATIC);
-			matrixCount = -1;
-			matrixText = "";
-
-        	MATRIXclear();
-        	for(int i=0; i < 25; i++) {
-        		MATRIXsetPixel(i%5, i/5, bitRead(iconLong, 24-i));
-        	}
+    void KniwwelinoLib::_MATRIXblit(uint8_t* buffer, uint32_t bits) {
+    	const uint8_t* map = MATRIX_MAP_FOR(rotation);
+    	uint8_t rows[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    	for (uint8_t i = 0; i < 25; i++) {
+    		if (bits & (1UL << (24-i))) {
+    			uint8_t m = map[i];
+    			rows[m >> 3] |= 1 << (m & 7);
+    		}
+    	}
+    	memcpy(buffer, rows, sizeof(rows));
+    	if (buffer == displaybuffer) {
+    		redrawMatrix = true;
+    		_TICKwake();
+    	}
     }
 
 	/*
@@ -1000,7 +2561,8 @@ void KniwwelinoLib::setSilent() {
 	 * on = true-> Pixel on, false->Pixel off.
 	 */
     void KniwwelinoLib::MATRIXsetPixel(uint8_t x, uint8_t y, uint8_t on) {
-    	matrixText = "";
+    	matrixAnim = nullptr;
+    	if (matrixText.length() > 0) matrixText = "";
     	matrixCount = -1;
     	drawPixel(x, y, on);
     }
@@ -1010,28 +2572,9 @@ void KniwwelinoLib::setSilent() {
 	 *
 	 */
     boolean KniwwelinoLib::MATRIXgetPixel(uint8_t x, uint8_t y) {
-    	// kniwwelino hardware specific: mirror cols
-    	int x1 = 4 - x;
-    	int y1 = y;
-    	// swap x/y
-//    	int a = x;
-//    	x = y;
-//    	y = a;
-
-  	  if (rotation == 0) {
-  		  x = y1;
-  		  y = x1;
-  	  } else if (rotation == 1) {
-  		  x = 4-x1;
-  		  y = y1;
-  	  } else if (rotation == 2) {
-  		  x = 4-y1;
-  		  y = 4-x1;
-  	  } else if (rotation == 3) {
-  		  x = x1;
-  		  y = 4-y1;
-  	  }
-    	return bitRead((uint8_t) displaybuffer[y], x);
+    	if ((x >= 5) || (y >= 5)) return false;
+    	uint8_t m = MATRIX_MAP_FOR(rotation)[y*5 + x];
+    	return bitRead(matrixDrawBuffer[m >> 3], m & 7);
     }
 
 	/*
@@ -1072,20 +2615,23 @@ void KniwwelinoLib::setSilent() {
 	 * Clears the Matrix.
 	 */
 	void KniwwelinoLib::MATRIXclear() {
-		matrixCount = 0;
-		for (uint8_t i = 0; i < 8; i++) {
-			displaybuffer[i] = 0;
+		if (matrixDrawBuffer != displaybuffer) {
+			// inside MATRIXbeginFrame/MATRIXcommitFrame, only the frame is cleared
+			_MATRIXblit(matrixDrawBuffer, 0);
+			return;
 		}
-		redrawMatrix = true;
+		matrixAnim = nullptr;
+		matrixCount = 0;
+		_TASKwake(TASK_MATRIX);
+		_MATRIXblit(displaybuffer, 0);
 	}
 
 
     void KniwwelinoLib::MATRIXsetStatus(uint8_t s) {
     	if (idShowing) return;
 
-    	for(int i=0; i < 25; i++) {
-    		MATRIXsetPixel(i%5, i/5, s<i);
-    	}
+    	// pixel i is on if s < i
+    	MATRIXblit(s < 24 ? (1UL << (24-s)) - 1 : 0);
     }
 
 	/*
@@ -1112,6 +2658,7 @@ void KniwwelinoLib::setSilent() {
 		}
 		Kniwwelino.MATRIXsetPixel(4, 4, 0);
 		redrawMatrix = true;
+		_TICKwake();
 	}
 
 	/*
@@ -1134,57 +2681,104 @@ void KniwwelinoLib::setSilent() {
 	 *
 	 */
     void KniwwelinoLib::drawPixel(int16_t x, int16_t y, uint16_t on) {
+    	if (matrixStripRender) {
+    		// rendering text into the column strip
+    		if ((y < 0) || (y >= 5) || (x < 0) || (x >= matrixStripLen)) return;
+    		if (on) matrixStrip[x] |= 1 << y;
+    		return;
+    	}
     	if ((y < 0) || (y >= 5)) return;
     	  if ((x < 0) || (x >= 5)) return;
-    	  // kniwwelino hardware specific: mirror cols
-    	  int x1 = 4 - x;
-    	  int y1 = y;
-    	  // swap x/y
-    	  //x = y1;
-    	  //y = x1;
-
-    	  if (rotation == 0) {
-    		  x = y1;
-    		  y = x1;
-    	  } else if (rotation == 1) {
-    		  x = 4-x1;
-    		  y = y1;
-    	  } else if (rotation == 2) {
-    		  x = 4-y1;
-    		  y = 4-x1;
-    	  } else if (rotation == 3) {
-    		  x = x1;
-    		  y = 4-y1;
-    	  }
 
+    	  uint8_t m = MATRIX_MAP_FOR(rotation)[y*5 + x];
     	  if (on) {
-    	    displaybuffer[y] |= 1 << x;
+    	    matrixDrawBuffer[m >> 3] |= 1 << (m & 7);
     	  } else {
-    	    displaybuffer[y] &= ~(1 << x);
+    	    matrixDrawBuffer[m >> 3] &= ~(1 << (m & 7));
+    	  }
+    	  if (matrixDrawBuffer == displaybuffer) {
+    		  redrawMatrix = true;
+    		  _TICKwake();
     	  }
-    	  redrawMatrix = true;
     }
 
 
+	/*
+	 * internal function that renders the matrix text once into a strip of columns,
+	 * so that scrolling only has to copy a 5 column window out of it.
+	 * the strip buffer is kept and only grows if a longer text is written.
+	 */
+    void KniwwelinoLib::_MATRIXrenderText() {
+    	// all TomThumb glyphs are 4 columns wide
+    	uint16_t len = matrixText.length() * 4;
+    	if (len > matrixStripSize) {
+    		uint8_t* strip = (uint8_t*) realloc(matrixStrip, len);
+    		if (strip == nullptr) {
+    			// out of memory -> text is rendered on every step instead.
+    			free(matrixStrip);
+    			matrixStrip = nullptr;
+    			matrixStripSize = 0;
+    			matrixStripLen = 0;
+    			return;
+    		}
+    		matrixStrip = strip;
+    		matrixStripSize = len;
+    	}
+    	matrixStripLen = len;
+    	if (len == 0) return;
+    	memset(matrixStrip, 0, len);
+
+    	matrixStripRender = true;
+    	setCursor(0,5);
+    	print(matrixText);
+    	matrixStripRender = false;
+    }
+
+	/*
+	 * internal function that shows the matrix text starting at column pos.
+	 */
+    void KniwwelinoLib::_MATRIXdrawText(int pos) {
+    	if (matrixStrip == nullptr) {
+    		for (uint8_t i = 0; i < 8; i++) {
+    			displaybuffer[i] = 0;
+    		}
+    		setCursor(pos,5);
+    		print(matrixText);
+    		return;
+    	}
+    	uint32_t pixels = 0;
+    	for (int x = 0; x < 5; x++) {
+    		int col = x - pos;
+    		if (col < 0 || col >= matrixStripLen) continue;
+    		uint8_t bits = matrixStrip[col];
+    		for (int y = 0; bits != 0; y++, bits >>= 1) {
+    			if (bits & 1) pixels |= 1UL << (24 - (y*5 + x));
+    		}
+    	}
+    	_MATRIXblit(displaybuffer, pixels);
+    }
+
 	/*
 	 * internal function that handles all matrix updates and text scrolling.
 	 * called by the ticker.
 	 */
     void KniwwelinoLib::_MATRIXupdate() {
+    	if (matrixAnim != nullptr) {
+    		// play animation
+    		_MATRIXanimate();
     	// move Matrix Text if active.
-    	if (matrixText.length()>0) {
-			if (matrixCount != 0 && (_tick%matrixScrollDiv) == 0) {
-				for (uint8_t i = 0; i < 8; i++) {
-					displaybuffer[i] = 0;
-				}
+    	} else if (matrixText.length()>0) {
+			if (matrixCount == 0) {
+				// last pass done, the text is no longer needed, sleep until the next one
+				matrixText = "";
+				tasks[TASK_MATRIX].idle = true;
+			} else if ((_tick%matrixScrollDiv) == 0) {
 				if (matrixText.length() == 1) {
-					setCursor(1,5);
-					print(matrixText);
+					_MATRIXdrawText(1);
 					redrawMatrix = true;
 					matrixCount = 0;
 				} else {
-					setCursor(matrixPos,5);
-					print(matrixText);
+					_MATRIXdrawText(matrixPos);
 					redrawMatrix = true;
 					matrixPos--;
 					if (matrixPos < -(((int)matrixText.length())*4)) {
@@ -1197,27 +2791,61 @@ void KniwwelinoLib::setSilent() {
 			}
 		// else handle icon
     	} else {
-    		// every sec.
-    		if ((_tick%2) == 0) {
-    			if (matrixCount > 0) matrixCount--;
+    		// every 1/10 sec, cleared once when the countdown runs out
+    		if ((_tick%2) == 0 && matrixCount > 0) {
+    			if (--matrixCount == 0) _MATRIXblit(displaybuffer, 0);
     		}
 
-    		if (matrixCount == 0) {
-    			MATRIXclear();
+    		if (matrixCount <= 0) {
+    			// static, cleared or expired icon, sleep until the next text, animation or timed icon
+    			// (matrixCount stays 0 after the countdown for MATRIXtextDone)
+    			tasks[TASK_MATRIX].idle = true;
     		}
     	}
+    }
 
+	/*
+	 * internal function that queues the matrix update if the displaybuffer changed.
+	 * called by the ticker.
+	 */
+    void KniwwelinoLib::_MATRIXflush() {
+    	if (redrawMatrix && bgI2C) _WORKpost(WORK_DISPLAY);
+    }
+
+	/*
+	 * internal function that sends the changed rows of the displaybuffer to the HT16K33.
+	 */
+    void KniwwelinoLib::_MATRIXsend() {
     	if (!redrawMatrix) return;
 
     	if (!bgI2C) return;
 
+    	// find the rows that differ from what the HT16K33 is showing
+    	uint8_t first = 0;
+    	uint8_t last = 7;
+    	if (matrixShadowValid) {
+    		while (first < 8 && displaybuffer[first] == matrixShadow[first]) first++;
+    		if (first == 8) {
+    			// same content, nothing to send
+    			redrawMatrix = false;
+    			return;
+    		}
+    		while (displaybuffer[last] == matrixShadow[last]) last--;
+    	}
+
+    	// each row takes 2 bytes of display RAM, the address auto-increments.
+    	// the unused high byte of the last row is only known to be 0 if the shadow is valid.
     	Wire.beginTransmission(HT16K33_ADDRESS);
-    	Wire.write(HT16K33_DISP_REGISTER); // start at address $00
-    	for (uint8_t i = 0; i < 8; i++) {
-    	  Wire.write(displaybuffer[i] & 0xFF);
-    	  Wire.write(displaybuffer[i] >> 8);
+    	Wire.write(HT16K33_DISP_REGISTER + first*2);
+    	for (uint8_t i = first; i <= last; i++) {
+    	  Wire.write(displaybuffer[i]);
+    	  if (i < last || !matrixShadowValid) Wire.write(0);
     	}
-    	Wire.endTransmission();
+    	// on a bus error keep the shadow and redrawMatrix -> retried on the next update
+    	if (Wire.endTransmission() != 0) return;
+
+    	memcpy(matrixShadow + first, displaybuffer + first, last - first + 1);
+    	matrixShadowValid = true;
     	redrawMatrix = false;
     }
 
@@ -1293,35 +2921,240 @@ void KniwwelinoLib::setSilent() {
     	return buttonB;
     }
 
+	/*
+	 * Selects how the buttons are read.
+	 *
+	 * pin = GPIO wired to the INT/ROW15 pin of the HT16K33 (e.g. D3).
+	 * The HT16K33 then pulls it low when a button is pressed and the buttons are only
+	 * read after that, without any I2C traffic while nothing is pressed.
+	 * -1 (default) polls the HT16K33 interrupt flag every tick and reads the keys only if it is set.
+	 */
+	void KniwwelinoLib::BUTTONsetInterruptPin(int8_t pin) {
+		if (buttonsIntPin >= 0) detachInterrupt(buttonsIntPin);
+		buttonsIntPin = pin;
+
+		Wire.beginTransmission(HT16K33_ADDRESS);
+		Wire.write(HT16K33_ROWINT_CMD | (pin >= 0 ? HT16K33_ROWINT_INT : 0));
+		Wire.endTransmission();
+
+		if (pin >= 0) {
+			pinMode(pin, INPUT_PULLUP);
+			attachInterrupt(pin, _ButtonsISR, FALLING);
+			// pick up a press that happened before
+			buttonsIRQ = true;
+		}
+	}
+
+	void ICACHE_RAM_ATTR KniwwelinoLib::_ButtonsISR() {
+		if (!Kniwwelino.buttonsIRQ) Kniwwelino.buttonsIRQTime = millis();
+		Kniwwelino.buttonsIRQ = true;
+	}
+
 	/*
 	 * Internal function to check the buttons states.
 	 * called by the ticker.
 	 *
 	 */
 	void KniwwelinoLib::_Buttonsread() {
+		// long press, repeat and click timeouts of all inputs
+		uint32_t now = millis();
+		for (uint8_t i = 0; i < EVENT_SOURCES; i++) {
+			Gesture &g = gestures[i];
+			if (g.down || g.raw || g.clicks > 0) _EVENTstep(i, now);
+		}
+
+		if (!bgI2C) return;
+		// in interrupt mode only after an interrupt and until all buttons are released
+		if (buttonsIntPin >= 0 && !buttonsIRQ && !buttonA && !buttonB) return;
+		_WORKpost(WORK_BUTTONS);
+	}
+
+	/*
+	 * Internal function that reads the buttons from the HT16K33.
+	 */
+	void KniwwelinoLib::_Buttonsscan() {
 
 		  if (!bgI2C) return;
 
-		  // read Buttons
-		  Wire.beginTransmission(HT16K33_ADDRESS);
-		  Wire.write(HT16K33_KEYINT_REGISTER);
-		  Wire.endTransmission();
-		  Wire.requestFrom(HT16K33_ADDRESS, 1);
-		  buttonsPressed = (Wire.read() != 0);
+		  boolean irq = buttonsIRQ;
+		  buttonsIRQ = false;
+
+		  // nothing pressed before -> check the interrupt flag first,
+		  // one combined write/read transaction, keys are only read if it is set.
+		  if (!buttonA && !buttonB && !irq) {
+			  Wire.beginTransmission(HT16K33_ADDRESS);
+			  Wire.write(HT16K33_KEYINT_REGISTER);
+			  Wire.endTransmission(false);
+			  Wire.requestFrom(HT16K33_ADDRESS, 1);
+			  buttonsPressed = (Wire.read() != 0);
+			  if (!buttonsPressed) return;
+		  }
 
+		  // read Buttons, this also clears the interrupt flag
 		  Wire.beginTransmission(HT16K33_ADDRESS);
 		  Wire.write(HT16K33_KEYS_REGISTER);
-		  Wire.endTransmission();
+		  Wire.endTransmission(false);
 
 		  Wire.requestFrom(HT16K33_ADDRESS, 2);
-		  buttonA = (Wire.read() != 0);
-		  buttonB = (Wire.read() != 0);
+		  boolean a = (Wire.read() != 0);
+		  boolean b = (Wire.read() != 0);
+
+		  // a press reported by the interrupt happened when the INT pin went low
+		  uint32_t now = millis();
+		  uint32_t pressTime = irq && buttonsIntPin >= 0 ? buttonsIRQTime : now;
+		  _EVENTinput(EVENT_BUTTON_A, a, a ? pressTime : now);
+		  _EVENTinput(EVENT_BUTTON_B, b, b ? pressTime : now);
+		  buttonA = a;
+		  buttonB = b;
 
 		  if (buttonA) buttonAClicked = true;
 		  if (buttonB) buttonBClicked = true;
 		  if (buttonA && buttonB) buttonABClicked = true;
+		  buttonsPressed = buttonA || buttonB;
+	}
+
+
+	//==== Input events ==========================================================
+
+	/*
+	 * Gets the next button or pin press/release, oldest first.
+	 * Every edge is kept, also if there are several between two calls.
+	 *
+	 * event.time = millis() of the edge
+	 * event.source = EVENT_BUTTON_A/EVENT_BUTTON_B/EVENT_PIN_D0/D5/D6/D7 (PINenableButton)
+	 * event.type = EVENT_PRESS/EVENT_RELEASE (debounced)
+	 *              EVENT_CLICK, EVENT_DOUBLE_CLICK (time = last release)
+	 *              EVENT_LONG_PRESS when held, then EVENT_REPEAT while still held
+	 *
+	 * returns false if there is no event.
+	 */
+	boolean KniwwelinoLib::EVENTpoll(KniwwelinoEvent& event) {
+		uint8_t tail = eventTail;
+		if (tail == eventHead) return false;
+		event = eventQueue[tail & (EVENT_QUEUE_SIZE - 1)];
+		eventTail = tail + 1;
+		return true;
+	}
+
+	/*
+	 * returns the number of events waiting to be read by EVENTpoll().
+	 */
+	uint8_t KniwwelinoLib::EVENTavailable() {
+		return (uint8_t)(eventHead - eventTail);
+	}
+
+	/*
+	 * Drops all waiting events.
+	 */
+	void KniwwelinoLib::EVENTclear() {
+		eventTail = eventHead;
+	}
+
+	/*
+	 * returns the number of events dropped because the queue was full
+	 * (EVENTpoll() not called often enough).
+	 */
+	uint32_t KniwwelinoLib::EVENTlost() {
+		return eventLost;
+	}
+
+	/*
+	 * Sets the timing of the input events for all buttons and pins.
+	 *
+	 * debounceMs = changes within this time after an edge are ignored (default EVENT_DEBOUNCE_MS)
+	 * doubleClickMs = max. time between two clicks of a double click, 0 = no double clicks,
+	 *                 EVENT_CLICK is reported right at the release then. (default EVENT_DOUBLECLICK_MS)
+	 * longPressMs = hold time until EVENT_LONG_PRESS (default EVENT_LONGPRESS_MS)
+	 * repeatMs = time between EVENT_REPEAT after the long press, 0 = no repeat (default EVENT_REPEAT_MS)
+	 */
+	void KniwwelinoLib::EVENTsetTiming(uint16_t debounceMs, uint16_t doubleClickMs, uint16_t longPressMs, uint16_t repeatMs) {
+		eventDebounce = debounceMs;
+		eventDoubleClick = doubleClickMs;
+		eventLongPress = longPressMs;
+		eventRepeat = repeatMs;
+	}
+
+	/*
+	 * internal function that feeds a new sample of a button/pin into its gesture state.
+	 */
+	void KniwwelinoLib::_EVENTinput(uint8_t source, boolean down, uint32_t time) {
+		Gesture &g = gestures[source];
+		if (down != g.raw) {
+			g.raw = down;
+			g.rawTime = time;
+			_TICKwake();
+		}
+		_EVENTstep(source, time);
+	}
+
+	/*
+	 * internal gesture state machine of one input.
+	 * the first edge is taken right away, bouncing is ignored for the debounce time.
+	 */
+	void KniwwelinoLib::_EVENTstep(uint8_t source, uint32_t now) {
+		Gesture &g = gestures[source];
+
+		if (g.raw != g.down && (uint32_t)(now - g.edgeTime) >= eventDebounce) {
+			// a change within the debounce time counts from its end
+			if ((uint32_t)(g.rawTime - g.edgeTime) < eventDebounce) g.rawTime = g.edgeTime + eventDebounce;
+			if (g.raw && g.clicks > 0 && (uint32_t)(g.rawTime - g.edgeTime) >= eventDoubleClick) {
+				// too late for a double click
+				_EVENTpush(source, EVENT_CLICK, g.edgeTime);
+				g.clicks = 0;
+			}
+			g.down = g.raw;
+			g.edgeTime = g.rawTime;
+			if (g.down) {
+				_EVENTpush(source, EVENT_PRESS, g.edgeTime);
+				g.longSent = false;
+			} else {
+				_EVENTpush(source, EVENT_RELEASE, g.edgeTime);
+				if (g.longSent) {
+					// a long press is no click
+					g.clicks = 0;
+				} else {
+					g.clicks++;
+				}
+			}
+		}
+
+		if (g.down) {
+			if (!g.longSent) {
+				if ((uint32_t)(now - g.edgeTime) >= eventLongPress) {
+					if (g.clicks > 0) {
+						_EVENTpush(source, EVENT_CLICK, now);
+						g.clicks = 0;
+					}
+					_EVENTpush(source, EVENT_LONG_PRESS, now);
+					g.longSent = true;
+					g.repeatTime = now;
+				}
+			} else if (eventRepeat > 0 && (uint32_t)(now - g.repeatTime) >= eventRepeat) {
+				_EVENTpush(source, EVENT_REPEAT, now);
+				g.repeatTime += eventRepeat;
+			}
+		} else if (g.clicks >= 2) {
+			_EVENTpush(source, EVENT_DOUBLE_CLICK, g.edgeTime);
+			g.clicks = 0;
+		} else if (g.clicks == 1 && (uint32_t)(now - g.edgeTime) >= eventDoubleClick) {
+			_EVENTpush(source, EVENT_CLICK, g.edgeTime);
+			g.clicks = 0;
+		}
 	}
 
+	void KniwwelinoLib::_EVENTpush(uint8_t source, uint8_t type, uint32_t time) {
+		sleepWake |= (source <= EVENT_BUTTON_B) ? SLEEP_BUTTON : SLEEP_PIN;
+		uint8_t head = eventHead;
+		if ((uint8_t)(head - eventTail) >= EVENT_QUEUE_SIZE) {
+			eventLost++;
+			return;
+		}
+		KniwwelinoEvent& e = eventQueue[head & (EVENT_QUEUE_SIZE - 1)];
+		e.time = time;
+		e.source = source;
+		e.type = type;
+		eventHead = head + 1;
+	}
 
 	//==== IOT: WIFI functions ==============================================
 
@@ -1593,7 +3426,10 @@ void KniwwelinoLib::setSilent() {
 		WiFi.hostByName(broker, brokerIP);
 		DEBUG_PRINT(F("Setting up MQTT Broker: "));DEBUG_PRINT(broker);DEBUG_PRINT(F(" "));DEBUG_PRINTLN(brokerIP.toString().c_str());
 		mqtt.begin(broker, port, wifi);
-		mqtt.onMessage(Kniwwelino._MQTTmessageReceived);
+		mqtt.onMessageAdvanced(Kniwwelino._MQTTmessageReceived);
+		_MQTTaddRoute(mqttTopicReqPwd.c_str(), false, nullptr, MQTT_ROUTE_PWD);
+		_MQTTaddRoute(mqttTopicUpdate.c_str(), false, nullptr, MQTT_ROUTE_UPDATE);
+		_MQTTaddRoute(mqttTopicLogEnabled.c_str(), false, nullptr, MQTT_ROUTE_LOG);
 		strcpy(Kniwwelino.mqttUser, user);
 		strcpy(Kniwwelino.mqttPW, password);
 		mqttEnabled = MQTTconnect(false);
@@ -1680,6 +3516,8 @@ void KniwwelinoLib::setSilent() {
 	 */
 	void KniwwelinoLib::MQTTsetGroup(String group) {
 		Kniwwelino.mqttGroup = DEF_MQTTBASETOPIC + group + "/";
+		if (adcPerMessage > 0) _ADCupdatePublish();
+		_MQTTbuildRoutes();
 	}
 
 	/*
@@ -1695,6 +3533,95 @@ void KniwwelinoLib::setSilent() {
     	mqttCallback = cb;
     }
 
+	/*
+	 * subscribes to the specified MQTT topic and calls the handler for its messages.
+	 * if an MQTT group is set, the topic is automatically preceded with this group string.
+	 * the topic may contain the wildcards + and #, e.g. "SENSOR/+/TEMP" or "SENSOR/#".
+	 * messages are passed without copying, see KniwwelinoMQTTHandler.
+	 * returns false if the subscription failed or too many handlers (MQTT_HANDLERS) are set.
+	 *
+	 * topic - topic to subscribe to
+	 * handler - function called for the messages, nullptr unsubscribes.
+	 *
+	 */
+    boolean KniwwelinoLib::MQTTon(const char topic[], KniwwelinoMQTTHandler handler) {
+    	int8_t i = -1;
+    	for (uint8_t j = 0; j < mqttRouteCount; j++) {
+    		if (mqttRoutes[j].internal == 0 && mqttRoutes[j].topic == topic) i = j;
+    	}
+
+    	if (handler == nullptr) {
+    		if (i >= 0) _MQTTremoveRoute(i);
+    		return MQTTunsubscribe(topic);
+    	}
+
+    	KniwwelinoMQTTHandler previous = (i >= 0) ? mqttRoutes[i].handler : nullptr;
+    	if (!_MQTTaddRoute(topic, true, handler, 0)) return false;
+    	if (MQTTsubscribe(topic)) return true;
+
+    	// not subscribed -> back to the previous route
+    	if (i >= 0) {
+    		mqttRoutes[i].handler = previous;
+    	} else {
+    		_MQTTremoveRoute(mqttRouteCount - 1);
+    	}
+    	return false;
+    }
+
+	/*
+	 * internal function that removes a route of the dispatch table.
+	 */
+    void KniwwelinoLib::_MQTTremoveRoute(uint8_t index) {
+    	mqttRouteCount--;
+    	for (uint8_t j = index; j < mqttRouteCount; j++) mqttRoutes[j] = mqttRoutes[j + 1];
+    	mqttRoutes[mqttRouteCount].topic = "";
+    	mqttRoutes[mqttRouteCount].full = "";
+    	_MQTTbuildRoutes();
+    }
+
+	/*
+	 * internal function that adds or replaces a route of the dispatch table.
+	 */
+    boolean KniwwelinoLib::_MQTTaddRoute(const char topic[], boolean inGroup, KniwwelinoMQTTHandler handler, uint8_t internal) {
+    	uint8_t i = 0;
+    	while (i < mqttRouteCount && !(mqttRoutes[i].topic == topic && mqttRoutes[i].inGroup == inGroup
+    			&& mqttRoutes[i].internal == internal)) {
+    		i++;
+    	}
+    	if (i == MQTT_HANDLERS) {
+    		DEBUG_PRINTLN(F("MQTTon: too many handlers"));
+    		return false;
+    	}
+    	if (i == mqttRouteCount) mqttRouteCount++;
+    	mqttRoutes[i].topic = topic;
+    	mqttRoutes[i].handler = handler;
+    	mqttRoutes[i].internal = internal;
+    	mqttRoutes[i].inGroup = inGroup;
+    	_MQTTbuildRoutes();
+    	return true;
+    }
+
+	/*
+	 * internal function that builds the dispatch table, on changes of the routes or the MQTT group.
+	 * exact topics go into the hash slots, topics with wildcards into a list.
+	 */
+    void KniwwelinoLib::_MQTTbuildRoutes() {
+    	memset(mqttRouteSlots, 0, sizeof(mqttRouteSlots));
+    	mqttWildcardCount = 0;
+    	for (uint8_t i = 0; i < mqttRouteCount; i++) {
+    		MQTTRoute &r = mqttRoutes[i];
+    		r.full = r.inGroup ? mqttGroup + r.topic : r.topic;
+    		if (r.full.indexOf('+') >= 0 || r.full.indexOf('#') >= 0) {
+    			mqttWildcards[mqttWildcardCount++] = i;
+    			continue;
+    		}
+    		r.hash = _mqttHash(r.full.c_str());
+    		uint8_t slot = r.hash & (MQTT_HASH_SLOTS - 1);
+    		while (mqttRouteSlots[slot] != 0) slot = (slot + 1) & (MQTT_HASH_SLOTS - 1);
+    		mqttRouteSlots[slot] = i + 1;
+    	}
+    }
+
 	/*
 	 * publishes/sents a message to the specified MQTT topic.
 	 * if an MQTT group is set, the topic is automatically preceded with this group string.
@@ -1885,6 +3812,7 @@ void KniwwelinoLib::setSilent() {
 	 *
 	 */
     void KniwwelinoLib::MQTTconnectRGB() {
+    	_MQTTaddRoute(MQTT_RGBCOLOR "/#", true, nullptr, MQTT_ROUTE_RGB);
     	KniwwelinoLib::MQTTsubscribe(String(MQTT_RGB) + "/#");
     	mqttRGB = true;
     }
@@ -1903,59 +3831,104 @@ void KniwwelinoLib::setSilent() {
 	 *
 	 */
     void KniwwelinoLib::MQTTconnectMATRIX() {
+    	_MQTTaddRoute(MQTT_MATRIXICON "/#", true, nullptr, MQTT_ROUTE_ICON);
+    	_MQTTaddRoute(MQTT_MATRIXTEXT "/#", true, nullptr, MQTT_ROUTE_TEXT);
     	KniwwelinoLib::MQTTsubscribe(String(MQTT_MATRIX) + "/#");
     	mqttMATRIX = true;
     }
 
 	/*
 	 * internal function to handle incoming messages on subscribed topics.
-	 *
+	 * called by the MQTT client with its receive buffers, payload is 0 terminated.
+	 */
+    void KniwwelinoLib::_MQTTmessageReceived(MQTTClient *client, char topic[], char payload[], int length) {
+    	Kniwwelino._MQTTdispatch(topic, payload ? payload : "", payload ? length : 0);
+    }
+
+	/*
+	 * internal function that passes a message to the handlers of the matching routes,
+	 * the exact topic by its hash and the topics with wildcards by pattern.
 	 */
-    void KniwwelinoLib::_MQTTmessageReceived(String &topic, String &payload) {
+    void KniwwelinoLib::_MQTTdispatch(const char topic[], const char payload[], unsigned int length) {
+    	sleepWake |= SLEEP_MQTT;
     	DEBUG_PRINT("MQTT messageReceived: ");
     	DEBUG_PRINT(topic);
     	DEBUG_PRINT(": ");
-    	if (payload) DEBUG_PRINTLN(""+payload);
-    	else DEBUG_PRINTLN("");
+    	DEBUG_PRINTLN(payload);
+
+    	// topic within the MQTT group for the handlers
+    	const char* groupTopic = topic;
+    	if (strncmp(topic, mqttGroup.c_str(), mqttGroup.length()) == 0) groupTopic += mqttGroup.length();
+
+    	uint32_t hash = _mqttHash(topic);
+    	for (uint8_t slot = hash & (MQTT_HASH_SLOTS - 1); mqttRouteSlots[slot] != 0; slot = (slot + 1) & (MQTT_HASH_SLOTS - 1)) {
+    		MQTTRoute &r = mqttRoutes[mqttRouteSlots[slot] - 1];
+    		// several routes may have the same topic, e.g. a handler on a platform topic
+    		if (r.hash == hash && strcmp(r.full.c_str(), topic) == 0) {
+    			if (r.internal) _MQTTinternal(r.internal, payload, length);
+    			else r.handler(r.inGroup ? groupTopic : topic, payload, length);
+    		}
+    	}
+    	for (uint8_t i = 0; i < mqttWildcardCount; i++) {
+    		MQTTRoute &r = mqttRoutes[mqttWildcards[i]];
+    		if (!_mqttMatch(r.full.c_str(), topic)) continue;
+    		if (r.internal) _MQTTinternal(r.internal, payload, length);
+    		else r.handler(r.inGroup ? groupTopic : topic, payload, length);
+    	}
+
+    	// for everything else -> call external callback function.
+    	if (mqttCallback != nullptr) {
+    		String t = groupTopic;
+    		String p = payload;
+    		mqttCallback(t, p);
+    	}
+    }
+
+	/*
+	 * internal function that handles the messages of the platform and of MQTTconnectRGB/MATRIX.
+	 */
+    void KniwwelinoLib::_MQTTinternal(uint8_t route, const char payload[], unsigned int length) {
+    	switch (route) {
     	// For the Platform update, login etc...
-    	if (topic == Kniwwelino.mqttTopicReqPwd) {
+    	case MQTT_ROUTE_PWD:
     		DEBUG_PRINTLN("MQTT->PLATTFORM PW Request");
-        	DEBUG_PRINT(F("MQTTpublish: "));DEBUG_PRINT(Kniwwelino.mqttTopicSentPwd);DEBUG_PRINT(F(" : "));DEBUG_PRINTLN(String(Kniwwelino.platformPW));
-        	Kniwwelino.mqtt.publish(Kniwwelino.mqttTopicSentPwd, String(Kniwwelino.platformPW));
-    	} else if (topic == Kniwwelino.mqttTopicUpdate) {
+        	DEBUG_PRINT(F("MQTTpublish: "));DEBUG_PRINT(mqttTopicSentPwd);DEBUG_PRINT(F(" : "));DEBUG_PRINTLN(platformPW);
+        	mqtt.publish(mqttTopicSentPwd, platformPW);
+        	break;
+    	case MQTT_ROUTE_UPDATE:
     		DEBUG_PRINTLN("MQTT->PLATTFORM UPDATE Request");
-			if (payload && payload.equals("configuration")) {
-				Kniwwelino.PLATFORMcheckConfUpdate();
-			} else if (payload && payload.equals("firmware")) {
-				if (! Kniwwelino.PLATFORMcheckFWUpdate()) {
-					Kniwwelino.MATRIXwriteAndWait("Update Failed! ");
+			if (strcmp(payload, "configuration") == 0) {
+				PLATFORMcheckConfUpdate();
+			} else if (strcmp(payload, "firmware") == 0) {
+				if (! PLATFORMcheckFWUpdate()) {
+					MATRIXwriteAndWait("Update Failed! ");
 				}
 			}
-    	} else if (topic == Kniwwelino.mqttTopicLogEnabled) {
+			break;
+    	case MQTT_ROUTE_LOG:
 			DEBUG_PRINTLN("MQTT->PLATTFORM MQTT LOG");
-			if (payload && payload.equals("on")) {
-				mqttLogEnabled = true;
-			} else {
-				mqttLogEnabled = false;
-			}
+			mqttLogEnabled = strcmp(payload, "on") == 0;
+			break;
 
 		// for simple LED and MAtrix functionalities
-    	} else if (Kniwwelino.mqttRGB && topic.startsWith(Kniwwelino.mqttGroup + MQTT_RGBCOLOR)) {
-    		Kniwwelino.RGBsetColorEffect(payload);
-    	} else if (Kniwwelino.mqttMATRIX && topic.startsWith(Kniwwelino.mqttGroup + MQTT_MATRIXICON)) {
-    		Kniwwelino.MATRIXdrawIcon(payload);
-    	} else if (Kniwwelino.mqttMATRIX && topic.startsWith(Kniwwelino.mqttGroup + MQTT_MATRIXTEXT)) {
-    		if (!payload || payload.length() == 0) {
-    			Kniwwelino.MATRIXclear();
+    	case MQTT_ROUTE_RGB:
+    		// several keyframes -> sequence played forever
+    		if (strchr(payload, ';') != nullptr || strchr(payload, '\n') != nullptr) {
+    			RGBplaySequence(payload, RGB_FOREVER);
     		} else {
-    			Kniwwelino.MATRIXwrite(payload, MATRIX_FOREVER, false);
+    			RGBsetColorEffect(payload);
     		}
-    	}
-
-    	// for everything else -> call external callback function.
-    	if (mqttCallback != nullptr) {
-        	topic.replace(Kniwwelino.mqttGroup, "");
-    		mqttCallback(topic, payload);
+    		break;
+    	case MQTT_ROUTE_ICON:
+    		MATRIXdrawIcon(payload, length);
+    		break;
+    	case MQTT_ROUTE_TEXT:
+    		if (length == 0) {
+    			MATRIXclear();
+    		} else {
+    			MATRIXwrite(payload, MATRIX_FOREVER, false);
+    		}
+    		break;
     	}
     }
 
@@ -1967,6 +3940,9 @@ void KniwwelinoLib::setSilent() {
     		mqtt.publish(mqttTopicStatus + "/firmware", fwVersion);
     		mqtt.publish(mqttTopicStatus + "/resetReason", ESP.getResetReason());
     		mqtt.publish(mqttTopicStatus + "/number", String(EEPROM.read(EEPROM_ADR_NUM)));
+    		if (profileEnabled) {
+    			mqtt.publish(mqttTopicStatus + "/tick", PROFILEreport());
+    		}
 			mqttLastPublished = millis();
     	}
     }
@@ -1980,8 +3956,8 @@ void KniwwelinoLib::setSilent() {
     boolean KniwwelinoLib::PLATFORMcheckFWUpdate() {
     	if (!updateMode) return true;
 		Kniwwelino.RGBsetColorEffect(STATE_UPDATE, RGB_BLINK, RGB_FOREVER);
-		//Kniwwelino.MATRIXdrawIcon(ICON_ARROW_DOWN);
-		Kniwwelino.MATRIXdrawIcon("B0010000100101010111000100:1:-1");
+		Kniwwelino.MATRIXdrawIcon(MATRIX_ICON("B0010000100101010111000100"));
+		Kniwwelino.MATRIXsetBlinkRate(MATRIX_BLINK_2HZ);
 
 
 		DEBUG_PRINT(getTime());
@@ -2011,7 +3987,8 @@ void KniwwelinoLib::setSilent() {
 		case HTTP_UPDATE_OK:
 			DEBUG_PRINTLN("\tHTTP_UPDATE_OK");
 			Kniwwelino.RGBsetColor(STATE_UPDATE);
-			Kniwwelino.MATRIXdrawIcon("B0111000000011100000011111:1:-1");
+			Kniwwelino.MATRIXdrawIcon(MATRIX_ICON("B0111000000011100000011111"));
+			Kniwwelino.MATRIXsetBlinkRate(MATRIX_BLINK_2HZ);
 			idShowing = false;
 			return true;
 		}
@@ -2248,6 +4225,215 @@ void KniwwelinoLib::setSilent() {
 		noTone(pin);
 	}
 
+	/*
+	 * Plays a melody in the background, loop() keeps running meanwhile.
+	 * melodies are queued and played one after the other (max. TONE_QUEUE_SIZE, including the one playing).
+	 * a PINsetEffect on the same pin waits until the melody is finished,
+	 * PINclear/PINenableButton on it stop the melodies (see TONEstop).
+	 * the notes/text have to stay valid until the melody is played.
+	 * returns false if the queue is full.
+	 *
+	 * pin - pin to output the sound
+	 * notes - frequencies (NOTE_C4, ...), 0 = pause
+	 * durations - type of note 4,8,16 as in playNote
+	 * length - number of notes
+	 */
+	boolean KniwwelinoLib::TONEplay(uint8_t pin, const unsigned int notes[], const uint8_t durations[], uint16_t length) {
+		return _TONEqueue(TONE_FORMAT_ARRAY, pin, notes, durations, length, 0);
+	}
+
+	/*
+	 * Plays a melody in RTTTL (ringtone) format in the background, see TONEplay.
+	 * the text may be in RAM or PROGMEM.
+	 * e.g. "Beep:d=8,o=5,b=120:c,e,g,2c6"
+	 */
+	boolean KniwwelinoLib::TONEplayRTTTL(uint8_t pin, const char rtttl[]) {
+		return _TONEqueue(TONE_FORMAT_RTTTL, pin, rtttl, nullptr, 0, 0);
+	}
+
+	/*
+	 * Plays a packed PROGMEM melody in the background, see TONEplay.
+	 * one byte per note, e.g. TONE_PACK(TONE_INDEX(4, 0), TONE_QUARTER) for a quarter C4.
+	 * bpm - quarter notes per minute
+	 */
+	boolean KniwwelinoLib::TONEplayPacked(uint8_t pin, const uint8_t melody[], uint16_t length, uint16_t bpm) {
+		return _TONEqueue(TONE_FORMAT_PACKED, pin, melody, nullptr, length, max(bpm, (uint16_t) 1));
+	}
+
+	/*
+	 * returns true while a melody is played or waiting.
+	 */
+	boolean KniwwelinoLib::TONEisPlaying() {
+		return tonePlaying;
+	}
+
+	/*
+	 * Stops the melody being played and removes the waiting ones.
+	 */
+	void KniwwelinoLib::TONEstop() {
+		os_timer_disarm(&toneTimer);
+		if (tonePlaying) noTone(toneQueue[toneTail].pin);
+		toneHead = toneTail;
+		tonePlaying = false;
+		// give the pin back to its effect
+		int8_t i = tonePinIndex;
+		tonePinIndex = -1;
+		if (i >= 0) _PINapply(i);
+	}
+
+	boolean KniwwelinoLib::_TONEqueue(uint8_t format, uint8_t pin, const void* notes, const uint8_t* durations, uint16_t length, uint16_t tempo) {
+		if (notes == nullptr) return false;
+		if (format == TONE_FORMAT_ARRAY && durations == nullptr) return false;
+		// one slot stays free to tell a full from an empty ring
+		uint8_t head = (toneHead + 1) % (TONE_QUEUE_SIZE + 1);
+		if (head == toneTail) {
+			DEBUG_PRINTLN(F("TONE: queue full"));
+			return false;
+		}
+		toneQueue[toneHead] = { format, pin, notes, durations, length, tempo };
+		toneHead = head;
+		if (!tonePlaying) _TONEstart();
+		return true;
+	}
+
+	/*
+	 * internal function that starts the melody at toneTail.
+	 * takes over the pin from its PINsetEffect until the melody ends.
+	 */
+	void KniwwelinoLib::_TONEstart() {
+		if (toneTail == toneHead) {
+			tonePlaying = false;
+			return;
+		}
+		tonePlaying = true;
+		ToneMelody &m = toneQueue[toneTail];
+		tonePos = 0;
+		tonePinIndex = _PINindex(m.pin);
+		if (tonePinIndex >= 0) {
+			os_timer_disarm(&ioPinTimer[tonePinIndex]);
+			// take the pin out of the PWM of the curve effects
+			if (ioPinStatus[tonePinIndex] > PIN_ON) analogWrite(m.pin, 0);
+		}
+
+		if (m.format == TONE_FORMAT_RTTTL) {
+			// "name:d=4,o=6,b=63:notes"
+			const char* s = (const char*) m.notes;
+			uint16_t bpm = 63;
+			toneDefDuration = 4;
+			toneDefOctave = 6;
+			char c;
+			while ((c = pgm_read_byte(s + tonePos)) != 0 && c != ':') tonePos++;
+			if (c == ':') tonePos++;
+			while ((c = pgm_read_byte(s + tonePos)) != 0 && c != ':') {
+				tonePos++;
+				if (pgm_read_byte(s + tonePos) != '=') continue;
+				tonePos++;
+				uint16_t v = _toneNumber(s, tonePos);
+				if (c == 'd' && v > 0) toneDefDuration = v;
+				else if (c == 'o') toneDefOctave = v;
+				else if (c == 'b' && v > 0) bpm = v;
+			}
+			if (c == ':') tonePos++;
+			toneWholeMs = 240000UL / bpm;
+		}
+
+		_TONEnext();
+	}
+
+	/*
+	 * internal function that starts the next note or the next melody.
+	 */
+	void KniwwelinoLib::_TONEnext() {
+		ToneMelody &m = toneQueue[toneTail];
+		uint16_t frequency;
+		uint32_t onMs;
+		if (!_TONEread(frequency, onMs, toneGapMs)) {
+			noTone(m.pin);
+			toneTail = (toneTail + 1) % (TONE_QUEUE_SIZE + 1);
+			int8_t i = tonePinIndex;
+			tonePinIndex = -1;
+			if (i >= 0) _PINapply(i);
+			_TONEstart();
+			return;
+		}
+		if (frequency > 0) {
+			tone(m.pin, frequency);
+		} else {
+			noTone(m.pin);
+		}
+		os_timer_arm(&toneTimer, max(onMs, (uint32_t) 1), false);
+	}
+
+	/*
+	 * internal function that reads the next note of the current melody.
+	 * returns false at its end.
+	 */
+	boolean KniwwelinoLib::_TONEread(uint16_t& frequency, uint32_t& onMs, uint32_t& offMs) {
+		ToneMelody &m = toneQueue[toneTail];
+
+		if (m.format == TONE_FORMAT_ARRAY) {
+			if (tonePos >= m.length) return false;
+			frequency = ((const unsigned int*) m.notes)[tonePos];
+			// same timing as playNote: the note and 30% of it as pause
+			onMs = 1000 / max(m.durations[tonePos], (uint8_t) 1);
+			offMs = onMs * 3 / 10;
+			tonePos++;
+			return true;
+		}
+
+		uint32_t ms;
+		if (m.format == TONE_FORMAT_PACKED) {
+			if (tonePos >= m.length) return false;
+			uint8_t b = pgm_read_byte((const uint8_t*) m.notes + tonePos++);
+			uint8_t index = b & 0x3F;
+			// 16th, 8th, quarter, half
+			ms = (15000UL << (b >> 6)) / m.tempo;
+			frequency = index == TONE_REST ? 0 : _toneFrequency(index - 1, (index - 1) / 12 + 3);
+		} else {
+			// RTTTL note: [duration]letter[#][.][octave][.]
+			const char* s = (const char*) m.notes;
+			char c;
+			while ((c = pgm_read_byte(s + tonePos)) == ',' || c == ' ') tonePos++;
+			if (c == 0) return false;
+
+			uint16_t duration = _toneNumber(s, tonePos);
+			if (duration == 0) duration = toneDefDuration;
+			static const uint8_t semitones[] = { 9, 11, 0, 2, 4, 5, 7 };	// a-g
+			c = pgm_read_byte(s + tonePos) | 0x20;
+			int8_t semitone = (c >= 'a' && c <= 'g') ? semitones[c - 'a'] : -1;	// 'p' = pause
+			if (pgm_read_byte(s + tonePos) != 0) tonePos++;
+			boolean dotted = false;
+			uint8_t octave = toneDefOctave;
+			while ((c = pgm_read_byte(s + tonePos)) != 0 && c != ',') {
+				if (c == '#') semitone++;
+				else if (c == '.') dotted = true;
+				else if (c >= '0' && c <= '9') octave = c - '0';
+				tonePos++;
+			}
+			ms = toneWholeMs / duration;
+			if (dotted) ms += ms / 2;
+			frequency = semitone < 0 ? 0 : _toneFrequency(semitone, octave + semitone / 12);
+		}
+		// a short pause keeps repeated notes apart
+		offMs = frequency > 0 ? ms / 8 : 0;
+		onMs = ms - offMs;
+		return true;
+	}
+
+	/*
+	 * internal timer function, ends the note and starts the next one after its pause.
+	 */
+	void KniwwelinoLib::_TONEtimer(void* arg) {
+		KniwwelinoLib &k = Kniwwelino;
+		if (k.toneGapMs > 0) {
+			noTone(k.toneQueue[k.toneTail].pin);
+			os_timer_arm(&k.toneTimer, k.toneGapMs, false);
+			k.toneGapMs = 0;
+			return;
+		}
+		k._TONEnext();
+	}
+
 	KniwwelinoLib* KniwwelinoLib::getNTPTimeObject;
 
 	void KniwwelinoLib::_initNTP() {
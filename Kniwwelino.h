@@ -19,6 +19,9 @@
 #include "KniwwelinoTones.h"
 
 #include <Ticker.h>
+extern "C" {
+#include "user_interface.h"
+}
 #include <Wire.h>
 #include <EEPROM.h>
 
@@ -61,6 +64,8 @@
 #define HT16K33_KEYS_REGISTER   0x40
 #define HT16K33_KEYINT_REGISTER 0x60
 #define HT16K33_BLINK_DISPLAYON 0x01
+#define HT16K33_ROWINT_CMD      0xA0	// | 0x01 = INT pin, | 0x02 = active high
+#define HT16K33_ROWINT_INT      0x01
 
 #define MATRIX_STATIC 			0
 #define MATRIX_BLINK_2HZ  		1
@@ -72,6 +77,10 @@
 #define MATRIX_SPEED			10
 #define MATRIX_FOREVER			-1
 #define MATRIX_SCROLL_DIV		3
+#define MATRIX_ANIM_MAX_FRAMES	32
+
+// animation frame: 25 pixels like the ICON_ constants + duration in ticks (1-127)
+#define MATRIX_FRAME(bits, ticks) ((((uint32_t)(ticks)) << 25) | ((uint32_t)(bits) & 0x1FFFFFF))
 
 #define EEPROM_ADR_UPDATE	510
 #define EEPROM_ADR_NUM		511
@@ -87,6 +96,11 @@
 #define RGB_UNUSED			-1
 #define RGB_SPARK			20
 #define RGB_GLOW			21
+#define RGB_FADE_IN			22
+#define RGB_FADE_OUT		23
+#define RGB_CURVE			24		// curve set by CURVEset()
+#define RGB_SEQUENCE		25		// keyframes set by RGBplaySequence()
+#define RGB_SEQ_MAX_KEYS	16
 
 #define PIN_ON				10
 #define PIN_BLINK			5
@@ -94,12 +108,35 @@
 #define PIN_OFF				0
 #define PIN_UNUSED			-1
 #define PIN_INPUT			-2
+#define PIN_TIMED			-3		// set by PINsetFrequency()
+#define PIN_COUNT			4
+#define PIN_PULSE_BUFFER	16		// power of 2, edges kept for PINgetPulseRate()
+#define PIN_PWM_RANGE		1023	// analogWriteRange set by begin()
+#define PIN_SPARK			RGB_SPARK
+#define PIN_GLOW			RGB_GLOW
+#define PIN_FADE_IN			RGB_FADE_IN
+#define PIN_FADE_OUT		RGB_FADE_OUT
+#define PIN_CURVE			RGB_CURVE
+
+#define ADC_WINDOWS			8		// power of 2, finished windows kept for publishing
+#define ADC_MAX_RATE		1000	// samples per second
+
+#define TONE_QUEUE_SIZE		4		// melodies queued, including the one playing
+// packed melodies: one byte per note, bits 0-5 = note index, bits 6-7 = length
+#define TONE_REST			0
+#define TONE_INDEX(octave, semitone)	(((octave) - 3) * 12 + (semitone) + 1)	// C3 = 1 ... D8 = 63
+#define TONE_16TH			0x00
+#define TONE_8TH			0x40
+#define TONE_QUARTER		0x80
+#define TONE_HALF			0xC0
+#define TONE_PACK(index, length)	((index) | (length))
 
 #define RGB_COLOR_RED 		0xFF0000
 #define RGB_COLOR_GREEN		0x00FF00
 #define RGB_COLOR_BLUE 		0x0000FF
 #define RGB_COLOR_ORANGE	0xC93B03
 #define RGB_COLOR_CYAN		0x00FFFF
+#define RGB_HEX_LEN			7		// "RRGGBB" + '\0' for RGBformatColor()
 
 #define STATE_WIFI      0x000022
 #define STATE_WIFIMGR   0x110022
@@ -132,6 +169,64 @@
 #define MQTT_MATRIX			  	"MATRIX"
 #define MQTT_MATRIXICON	      	"MATRIX/ICON"
 #define MQTT_MATRIXTEXT	      	"MATRIX/TEXT"
+#define MQTT_HANDLERS			16		// topics of MQTTon() plus up to 6 internal ones (platform, RGB, MATRIX)
+#define MQTT_HASH_SLOTS			32		// power of 2, more than MQTT_HANDLERS
+
+// background tasks run by the ticker, periods in ticks (TICK_FREQ)
+#define TASK_PINS				0
+#define TASK_RGB				1
+#define TASK_MATRIX				2
+#define TASK_DISPLAY			3
+#define TASK_BUTTONS			4
+#define TASK_USER				5
+#define TASK_MAX				8
+
+#define PROFILE_PINS			TASK_PINS
+#define PROFILE_RGB				TASK_RGB
+#define PROFILE_MATRIX			TASK_MATRIX
+#define PROFILE_DISPLAY			TASK_DISPLAY
+#define PROFILE_BUTTONS			TASK_BUTTONS
+#define PROFILE_TICK			TASK_MAX
+#define PROFILE_STAGES			(TASK_MAX + 1)
+#define PROFILE_BUDGET_US		5000
+
+// bus work posted by the ticker, done by loop()/sleep()
+#define WORK_DISPLAY			0
+#define WORK_BUTTONS			1
+#define WORK_I2C				2
+#define WORK_QUEUE_SIZE			8		// power of 2
+#define WORK_MAX_DELAY			3		// ticks before the ticker does the work itself
+
+#define I2C_QUEUE_SIZE			8		// power of 2
+#define I2C_PENDING				-1
+#define I2C_ERR_READ			5
+
+// wake up reasons of sleepUntil()
+#define SLEEP_TIMEOUT			0x00
+#define SLEEP_MQTT				0x01
+#define SLEEP_BUTTON			0x02
+#define SLEEP_PIN				0x04
+#define SLEEP_ANY				0x07
+
+// input events, see EVENTpoll()
+#define EVENT_BUTTON_A			0
+#define EVENT_BUTTON_B			1
+#define EVENT_PIN_D0			2
+#define EVENT_PIN_D5			3
+#define EVENT_PIN_D6			4
+#define EVENT_PIN_D7			5
+#define EVENT_SOURCES			6
+#define EVENT_PRESS				0
+#define EVENT_RELEASE			1
+#define EVENT_CLICK				2
+#define EVENT_DOUBLE_CLICK		3
+#define EVENT_LONG_PRESS		4
+#define EVENT_REPEAT			5
+#define EVENT_QUEUE_SIZE		16		// power of 2
+#define EVENT_DEBOUNCE_MS		30
+#define EVENT_DOUBLECLICK_MS	300
+#define EVENT_LONGPRESS_MS		800
+#define EVENT_REPEAT_MS			200
 
 #define NTP_SERVER			  	"lu.pool.ntp.org"
 #define NTP_PORT			  	8888
@@ -141,6 +236,27 @@
 static uint32_t _tick = 0;
 static boolean mqttLogEnabled = false;
 
+// input event from EVENTpoll()
+struct KniwwelinoEvent {
+	uint32_t time;		// millis()
+	uint8_t source;		// EVENT_BUTTON_A/B, EVENT_PIN_D0/D5/D6/D7
+	uint8_t type;		// EVENT_PRESS/RELEASE/CLICK/DOUBLE_CLICK/LONG_PRESS/REPEAT
+};
+
+// handler for MQTTon(), topic without the MQTT group, payload is 0 terminated.
+typedef void (*KniwwelinoMQTTHandler)(const char topic[], const char payload[], unsigned int length);
+
+// I2C transaction for I2Csubmit(): writes tx, then reads rx from the device.
+struct KniwwelinoI2C {
+	uint8_t address;
+	const uint8_t* tx;
+	uint8_t txLen;
+	uint8_t* rx;
+	uint8_t rxLen;
+	void (*done)(KniwwelinoI2C* transaction);	// optional, called when finished
+	volatile int8_t status;						// I2C_PENDING, 0 = ok, else Wire error
+};
+
 class KniwwelinoLib: public Adafruit_GFX {
 public:
 
@@ -159,10 +275,36 @@ public:
 		String getIP();
 		String getMAC();
 		void sleep(unsigned long millis);
+		uint8_t sleepUntil(uint8_t events, unsigned long timeout);
 		void loop();
 		boolean isConnected();
 		void bgI2CStop();
 		void bgI2CStart();
+		boolean I2Csubmit(KniwwelinoI2C* transaction);
+		int8_t I2Ctransfer(uint8_t address, const uint8_t* tx, uint8_t txLen, uint8_t* rx, uint8_t rxLen);
+		void bgTick();
+		void bgTickStop();
+		void bgTickStart();
+		void bgTickIdle(uint16_t idleMillis);
+
+//====  Tick profiling =======================================================
+
+		void PROFILEenable(boolean on);
+		void PROFILEreset();
+		void PROFILEsetBudget(uint32_t budgetMicros);
+		uint32_t PROFILEmin(uint8_t stage);
+		uint32_t PROFILEavg(uint8_t stage);
+		uint32_t PROFILEmax(uint8_t stage);
+		uint32_t PROFILEticks();
+		uint32_t PROFILEoverruns();
+		uint32_t PROFILEskipped();
+		String PROFILEreport();
+
+//====  Background tasks =====================================================
+
+		int TASKadd(void (*task)(), uint16_t period, uint16_t phase);
+		void TASKremove(uint8_t id);
+		void TASKsetPeriod(uint8_t id, uint16_t period, uint16_t phase);
 
 //====  logging  =============================================================
 
@@ -174,10 +316,28 @@ public:
 //====  IO Functions =========================================================
 
 		void PINsetEffect(uint8_t pin, int effect);
+		void PINsetFrequency(uint8_t pin, float frequency, uint8_t duty);
 		void PINclear(uint8_t pin);
 		void PINenableButton(uint8_t pin);
 		boolean PINbuttonClicked(uint8_t pin);
 		boolean PINbuttonDown(uint8_t pin);
+		void PINenableCounter(uint8_t pin);
+		void PINenableCounter(uint8_t pin, uint32_t debounceMicros);
+		uint32_t PINgetPulseCount(uint8_t pin);
+		float PINgetPulseRate(uint8_t pin);
+		void PINresetPulseCount(uint8_t pin);
+
+//==== Analog input =========================================================
+
+		boolean ADCstart(uint16_t sampleRate, uint16_t windowSamples);
+		void ADCstop();
+		void ADCpublish(const char topic[], uint8_t windowsPerMessage);
+		uint16_t ADClast();
+		boolean ADCwindowDone();
+		uint16_t ADCmin();
+		uint16_t ADCmax();
+		float ADCmean();
+		float ADCstddev();
 
 //==== RGB LED  functions ====================================================
 
@@ -190,9 +350,19 @@ public:
 		void RGBsetColorEffect(uint8_t red, uint8_t green, uint8_t blue,
 				uint8_t effect, int count);
 		void RGBsetColorEffect(String colorEffect);
+		void RGBsetColorEffect(const char colorEffect[]);
+		boolean RGBparseColor(const char str[], uint32_t& color);
+		boolean RGBparseColor(const char str[], uint16_t len, uint32_t& color);
+		char* RGBformatColor(uint32_t color, char buffer[RGB_HEX_LEN]);
 		void RGBclear();
 		void RGBsetBrightness(uint8_t b);
 		uint32_t RGBgetColor();
+		boolean RGBplaySequence(const char sequence[], int loops);
+		boolean RGBplaySequence(String sequence, int loops);
+		boolean RGBplaySequenceFile(String fileName, int loops);
+		uint32_t RGBshowCount();
+		uint32_t RGBshowSkipped();
+		void CURVEset(const uint8_t* curve, uint8_t len);
 		unsigned long RGBhex2int(String col);
 		unsigned long RGBhue2int(uint8_t hue);
 		String RGBcolor2Hex(unsigned long color);
@@ -208,7 +378,18 @@ public:
 		void MATRIXwriteAndWait(String text);
 		void MATRIXwrite(String text, int count, boolean wait);
 		void MATRIXdrawIcon(String iconString);
+		void MATRIXdrawIcon(const char iconString[]);
+		void MATRIXdrawIcon(const char iconString[], uint16_t len);
 		void MATRIXdrawIcon(uint32_t iconLong);
+		void MATRIXblit(uint32_t bits);
+		void MATRIXblitRows(const uint8_t rows[5]);
+		void MATRIXbeginFrame();
+		void MATRIXcommitFrame();
+		void MATRIXplayAnimation(const uint32_t* frames, uint8_t count, int loops);
+		boolean MATRIXplayIcons(String iconString, int loops);
+		boolean MATRIXplayAnimationFile(String fileName, int loops);
+		void MATRIXstopAnimation();
+		boolean MATRIXanimationDone();
 		void MATRIXsetPixel(uint8_t x, uint8_t y, boolean on);
 		boolean MATRIXgetPixel(uint8_t x, uint8_t y);
 		void MATRIXsetBrightness(uint8_t brightness);
@@ -227,6 +408,15 @@ public:
 		boolean BUTTONABclicked();
 		boolean BUTTONAdown();
 		boolean BUTTONBdown();
+		void BUTTONsetInterruptPin(int8_t pin);
+
+//==== Input events ==========================================================
+
+		boolean EVENTpoll(KniwwelinoEvent& event);
+		uint8_t EVENTavailable();
+		void EVENTclear();
+		uint32_t EVENTlost();
+		void EVENTsetTiming(uint16_t debounceMs, uint16_t doubleClickMs, uint16_t longPressMs, uint16_t repeatMs);
 
 //==== IOT functions ==============================================
 
@@ -246,6 +436,7 @@ public:
 		boolean MQTTunsubscribepublic(const char topic[]);
 		void MQTTsetGroup(String group);
 		void MQTTonMessage(void (*)(String &topic, String &message));
+		boolean MQTTon(const char topic[], KniwwelinoMQTTHandler handler);
 		void MQTTconnectRGB();
 		void MQTTconnectMATRIX();
 
@@ -261,6 +452,11 @@ public:
 		void playNote(uint8_t pin, unsigned int note, uint8_t noteDuration);
 		void playTone(uint8_t pin, unsigned int note);
 		void toneOff(uint8_t pin);
+		boolean TONEplay(uint8_t pin, const unsigned int notes[], const uint8_t durations[], uint16_t length);
+		boolean TONEplayRTTTL(uint8_t pin, const char rtttl[]);
+		boolean TONEplayPacked(uint8_t pin, const uint8_t melody[], uint16_t length, uint16_t bpm);
+		boolean TONEisPlaying();
+		void TONEstop();
 
 //==== Date Time functions ==============================================
 		String getTime();
@@ -268,14 +464,66 @@ public:
 //==== Private functions =====================================================
 
 	private:
+#ifdef KNIWWELINO_HOST
+		// the host benchmark (extras/host) drives the tick and the MQTT callback directly
+		friend struct KniwwelinoHostBench;
+#endif
 
 		static void _baseTick();
+		static void _ButtonsISR();
+		void _EVENTpush(uint8_t source, uint8_t type, uint32_t time);
+		void _EVENTinput(uint8_t source, boolean down, uint32_t time);
+		void _EVENTstep(uint8_t source, uint32_t now);
+		boolean _CURVEstep(uint8_t effect, uint8_t& phase, uint8_t& level);
+		void _RGBshow();
+		void _RGBsequence();
+		void _TASKrun(uint8_t id);
+		void _TASKwake(uint8_t id);
+		boolean _TICKisIdle();
+		void _TICKsetIdle(boolean idle);
+		void _TICKwake();
+		void _TICKattach(uint16_t periodMs);
+		void _TASKsetup(uint8_t id, void (KniwwelinoLib::*method)(), uint16_t period, uint16_t phase, boolean i2c);
+		void _PROFILEtickStart();
+		void _PROFILEadd(uint8_t stage, uint32_t cycles);
 		void _PINhandle();
+		int8_t _PINindex(uint8_t pin);
+		void _PINstartTimer(uint8_t index, uint32_t onMs, uint32_t offMs);
+		static void _PINtimer(void* arg);
+		template<uint8_t I> static void _PINisr();
+		void _PINpulse(uint8_t index, uint32_t time);
+		void _PINstopCounter(uint8_t index);
+		void _PINapply(uint8_t index);
+		boolean _TONEqueue(uint8_t format, uint8_t pin, const void* notes, const uint8_t* durations, uint16_t length, uint16_t tempo);
+		void _TONEstart();
+		void _TONEnext();
+		boolean _TONEread(uint16_t& frequency, uint32_t& onMs, uint32_t& offMs);
+		static void _TONEtimer(void* arg);
+		static void _ADCsample();
+		void _ADCupdatePublish();
+		void _ADCsend();
 		void _RGBblink();
 		void drawPixel(int16_t x, int16_t y, uint16_t color); // Draw a specific pixel
 		void _MATRIXupdate();
+		void _MATRIXflush();
+		void _MATRIXsend();
+		void _MATRIXrenderText();
+		void _MATRIXdrawText(int pos);
+		void _MATRIXblit(uint8_t* buffer, uint32_t bits);
+		void _MATRIXanimate();
+		uint8_t _MATRIXloadFrames(const char* s, uint16_t len);
+		uint16_t _MATRIXparseIcon(const char* s, uint16_t len, uint32_t &bits, int32_t fields[2], uint8_t &fieldCount);
 		void _Buttonsread();
-		static void _MQTTmessageReceived(String &topic, String &payload);
+		void _Buttonsscan();
+		void _WORKpost(uint8_t work);
+		void _WORKdrain(boolean userI2C = true);
+		void _I2Crun(KniwwelinoI2C* t);
+		static void _MQTTmessageReceived(MQTTClient *client, char topic[], char payload[], int length);
+		void _MQTTdispatch(const char topic[], const char payload[], unsigned int length);
+		void _MQTTinternal(uint8_t route, const char payload[], unsigned int length);
+		boolean _MQTTaddRoute(const char topic[], boolean inGroup, KniwwelinoMQTTHandler handler, uint8_t internal);
+		void _MQTTremoveRoute(uint8_t index);
+		void _MQTTbuildRoutes();
 		void _MQTTupdateStatus(boolean force);
 		boolean PLATFORMcheckFWUpdate();
 		boolean PLATFORMcheckConfUpdate();
@@ -307,16 +555,82 @@ public:
 		byte ioPinNumers[4] = { D0, D5, D6, D7 };
 		int ioPinStatus[4] = { PIN_UNUSED, PIN_UNUSED, PIN_UNUSED, PIN_UNUSED };
 		boolean ioPinclicked[4] = { false, false, false, false };
-		int pinBlinkCount = 1;
+		uint8_t ioPinPhase[4] = { 0, 0, 0, 0 };		// position in the PIN_CURVE cycle
+		// timed blink/frequency output, one timer per pin
+		os_timer_t ioPinTimer[PIN_COUNT];
+		uint32_t ioPinOnMs[PIN_COUNT];
+		uint32_t ioPinOffMs[PIN_COUNT];
+		volatile boolean ioPinLevel[PIN_COUNT];
+		// pulse counters, filled by the edge interrupt (by polling on D0)
+		boolean ioPinCounter[PIN_COUNT] = { false, false, false, false };
+		uint32_t ioPinDebounce[PIN_COUNT];
+		volatile uint32_t ioPinPulses[PIN_COUNT];
+		volatile uint8_t ioPinPulseHead[PIN_COUNT];
+		volatile uint32_t ioPinPulseTimes[PIN_COUNT][PIN_PULSE_BUFFER];	// micros()
+
+		// ANALOG sampler, windows are filled by adcTicker and published by loop()
+		struct ADCWindow {
+			uint16_t min;
+			uint16_t max;
+			uint16_t count;
+			uint32_t sum;
+			uint64_t sumSquares;
+		};
+		Ticker adcTicker;
+		uint16_t adcWindowSamples = 0;
+		volatile uint16_t adcLast = 0;
+		ADCWindow adcCurrent;
+		ADCWindow adcWindows[ADC_WINDOWS];
+		volatile uint8_t adcHead = 0;		// next window written by the sampler
+		uint8_t adcTail = 0;				// next window published
+		uint8_t adcRead = 0;				// adcHead at the last ADCwindowDone()
+		boolean adcHasData = false;			// a window has been finished since ADCstart()
+		String adcTopicName;
+		String adcTopic;					// mqttGroup + adcTopicName
+		uint8_t adcPerMessage = 0;			// 0 = no publishing
+
+		// TONE melodies, played by toneTimer one note after the other
+		struct ToneMelody {
+			uint8_t format;
+			uint8_t pin;
+			const void* notes;				// frequencies, RTTTL text or packed bytes
+			const uint8_t* durations;
+			uint16_t length;
+			uint16_t tempo;					// bpm
+		};
+		ToneMelody toneQueue[TONE_QUEUE_SIZE + 1];
+		uint8_t toneHead = 0;
+		uint8_t toneTail = 0;				// melody being played
+		boolean tonePlaying = false;
+		int8_t tonePinIndex = -1;			// ioPin taken over by the melody, its effect waits
+		os_timer_t toneTimer;
+		uint16_t tonePos = 0;				// next note or RTTTL character
+		uint32_t toneGapMs = 0;				// silence after the current note
+		uint32_t toneWholeMs = 0;			// RTTTL whole note
+		uint8_t toneDefDuration = 4;		// RTTTL defaults
+		uint8_t toneDefOctave = 6;
 
 		// MATRIX
 		boolean redrawMatrix = true;
 		String matrixText;
+		uint8_t* matrixStrip = nullptr;		// pre-rendered text, one byte (5 rows) per column
+		uint16_t matrixStripLen = 0;
+		uint16_t matrixStripSize = 0;
+		boolean matrixStripRender = false;
 		int matrixCount = -1;
 		int matrixPos = 0;
-		int iconcount = 0;
-		int iconnum = 0;
 		uint8_t displaybuffer[8];
+		uint8_t matrixShadow[8];			// display RAM content as last sent to the HT16K33
+		boolean matrixShadowValid = false;
+		uint8_t matrixBackBuffer[8];		// frame being drawn between MATRIXbeginFrame/MATRIXcommitFrame
+		uint8_t* matrixDrawBuffer = displaybuffer;
+		const uint32_t* matrixAnim = nullptr;	// running animation (nullptr = none)
+		boolean matrixAnimProgmem = false;
+		uint8_t matrixAnimLen = 0;
+		uint8_t matrixAnimPos = 0;
+		uint8_t matrixAnimWait = 0;
+		int matrixAnimLoops = 0;
+		uint32_t matrixAnimFrames[MATRIX_ANIM_MAX_FRAMES];	// frames loaded from file
 		uint8_t rotation = 0;
 		boolean idShowing = false;
 		uint8_t matrixScrollDiv = MATRIX_SCROLL_DIV;
@@ -326,8 +640,26 @@ public:
 		uint32_t rgbColor = 0;
 		int rgbEffect = RGB_ON;
 		int rgbEffectCount = -1;
-		int rgbEffectBrightness = RGB_BRIGHTNESS;
-		int rgbEffectModifier = 1;
+		uint8_t rgbEffectPhase = 0;
+		// RGB_SEQUENCE keyframes
+		struct RGBKey {
+			uint32_t color;
+			uint16_t ticks;		// duration in ticks (20 = 1sec)
+			boolean fade;		// fade to the next key, else hold
+		};
+		RGBKey rgbSeq[RGB_SEQ_MAX_KEYS];
+		uint8_t rgbSeqLen = 0;
+		uint8_t rgbSeqPos = 0;
+		uint16_t rgbSeqTick = 0;
+		int32_t rgbSeqLevel[3];			// current r,g,b in 8.8 fixed point
+		int32_t rgbSeqDelta[3];			// change per tick in 8.8 fixed point
+		uint8_t rgbLatched[3];			// pixel bytes last sent to the LED
+		boolean rgbLatchedValid = false;
+		uint32_t rgbShows = 0;
+		uint32_t rgbShowsSkipped = 0;
+		// user curve for RGB_CURVE/PIN_CURVE
+		const uint8_t* curveUser = nullptr;
+		uint8_t curveUserLen = 0;
 		int rgbBlinkCount = 1;
 		int rgbBrightness = RGB_BRIGHTNESS;
 
@@ -338,9 +670,73 @@ public:
 		boolean buttonAClicked;
 		boolean buttonBClicked;
 		boolean buttonABClicked;
+		int8_t buttonsIntPin = -1;			// GPIO at the HT16K33 INT pin, -1 = poll the INT flag
+		volatile boolean buttonsIRQ = false;
+		volatile uint32_t buttonsIRQTime = 0;
+
+		// EVENTS, filled by the button/pin scan, read by EVENTpoll()
+		KniwwelinoEvent eventQueue[EVENT_QUEUE_SIZE];
+		volatile uint8_t eventHead = 0;
+		volatile uint8_t eventTail = 0;
+		uint32_t eventLost = 0;
+		volatile uint8_t sleepWake = 0;		// SLEEP_ bits seen since sleepUntil() started
+
+		// gesture state per input
+		struct Gesture {
+			boolean raw;			// last sample
+			boolean down;			// debounced state
+			boolean longSent;		// long press reported for this press
+			uint8_t clicks;			// clicks waiting for the double click time
+			uint32_t rawTime;		// time of the last sample change
+			uint32_t edgeTime;		// time of the last debounced edge
+			uint32_t repeatTime;	// time of the last long press/repeat event
+		};
+		Gesture gestures[EVENT_SOURCES] = {};
+		uint16_t eventDebounce = EVENT_DEBOUNCE_MS;
+		uint16_t eventDoubleClick = EVENT_DOUBLECLICK_MS;
+		uint16_t eventLongPress = EVENT_LONGPRESS_MS;
+		uint16_t eventRepeat = EVENT_REPEAT_MS;
 
 		// TICKER
 		Ticker baseTicker;
+		struct Task {
+			void (KniwwelinoLib::*method)();	// built-in task
+			void (*function)();					// user task
+			uint16_t period;					// 0 = disabled
+			uint16_t phase;
+			boolean i2c;						// task uses the I2C bus
+			boolean pending;					// deferred from an earlier tick
+			boolean idle;						// nothing to do until woken up
+		};
+		Task tasks[TASK_MAX];
+		boolean tickI2CUsed = false;
+		boolean tickRunning = true;			// false after bgTickStop()
+		boolean tickIdle = false;			// slowed down/stopped because nothing to do
+		uint16_t tickIdleMillis = 0;		// tick period when idle, 0 = never idle
+		uint32_t tickPeriodMicros = 0;		// period the ticker is armed with, 0 = stopped
+
+		// bus work queues, used by loop() and the ticker, which never preempt each other
+		uint8_t workQueue[WORK_QUEUE_SIZE];
+		volatile uint8_t workHead = 0;
+		volatile uint8_t workTail = 0;
+		volatile uint8_t workQueued = 0;	// bit per WORK_ type in the queue
+		uint8_t workAge = 0;
+		KniwwelinoI2C* i2cQueue[I2C_QUEUE_SIZE];
+		volatile uint8_t i2cHead = 0;
+		volatile uint8_t i2cTail = 0;
+
+		// PROFILING
+		boolean profileEnabled = false;
+		uint32_t profileMin[PROFILE_STAGES];
+		uint32_t profileMax[PROFILE_STAGES];
+		uint64_t profileTotal[PROFILE_STAGES];
+		uint32_t profileCalls[PROFILE_STAGES];
+		uint32_t profileTicks = 0;
+		uint32_t profileOverruns = 0;
+		uint32_t profileSkipped = 0;
+		uint32_t profileLastTick = 0;
+		boolean profileTickRestart = true;	// ticker (re)armed since the last tick
+		uint32_t profileBudget = PROFILE_BUDGET_US;
 
 		// Wifi
 		boolean wifiEnabled = true;
@@ -364,6 +760,21 @@ public:
 		boolean mqttRGB = false;
 		boolean mqttMATRIX = false;
 
+		// MQTT dispatch table, exact topics by hash, wildcard topics by pattern
+		struct MQTTRoute {
+			String topic;					// as registered
+			String full;					// with the MQTT group
+			uint32_t hash;
+			KniwwelinoMQTTHandler handler;
+			uint8_t internal;				// MQTT_ROUTE_*, 0 = handler
+			boolean inGroup;
+		};
+		MQTTRoute mqttRoutes[MQTT_HANDLERS];
+		uint8_t mqttRouteCount = 0;
+		uint8_t mqttRouteSlots[MQTT_HASH_SLOTS] = {};	// route + 1, 0 = empty
+		uint8_t mqttWildcards[MQTT_HANDLERS];
+		uint8_t mqttWildcardCount = 0;
+
 		// plattform / conf
 		char platformPW[20];
 		char confPersonalParameters[256];
@@ -24,4 +24,60 @@
 #define ICON_ARROW_RIGHT    0x417C44
 #define ICON_ARROW_LEFT     0x447D04
 
+/*
+ * Compile time icons.
+ * MATRIX_ICON("B0010000100101010111000100") or MATRIX_ICON("0x7008E828A0")
+ * turns an icon string in the MATRIXdrawIcon formats into the 32bit icon value
+ * while compiling. Malformed strings give a compile error mentioning
+ * KniwwelinoIconError_invalid_icon_string.
+ *
+ * "B0010000100101010111000100"_icon does the same, but is only checked while
+ * compiling when used in a constexpr context.
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+// not constexpr on purpose: using it while compiling is an error.
+uint32_t KniwwelinoIconError_invalid_icon_string();
+
+// helpers of kniwwelinoIcon(), not part of the API
+namespace kniwwelino_detail {
+
+constexpr int8_t iconHex(char c) {
+	return (c >= '0' && c <= '9') ? c - '0' :
+		   (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+		   (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+}
+
+constexpr uint32_t iconBin(const char* s, uint8_t i, uint32_t bits) {
+	return (i > 25) ? bits :
+		   (s[i] == '0' || s[i] == '1') ? iconBin(s, i + 1, (bits << 1) | (s[i] - '0')) :
+		   KniwwelinoIconError_invalid_icon_string();
+}
+
+constexpr uint32_t iconRows(const char* s, uint8_t i, uint32_t bits) {
+	return (i >= 12) ? bits :
+		   (iconHex(s[i]) >= 0 && iconHex(s[i + 1]) >= 0) ?
+				   iconRows(s, i + 2, (bits << 5) | (iconHex(s[i]) << 1) | (iconHex(s[i + 1]) >> 3)) :
+		   KniwwelinoIconError_invalid_icon_string();
+}
+
+template<uint32_t icon> struct IconConst {
+	enum : uint32_t { value = icon };
+};
+
+} // namespace kniwwelino_detail
+
+constexpr uint32_t kniwwelinoIcon(const char* s, size_t len) {
+	return (len == 26 && (s[0] == 'B' || s[0] == 'b')) ? kniwwelino_detail::iconBin(s, 1, 0) :
+		   (len == 12 && s[0] == '0' && s[1] == 'x') ? kniwwelino_detail::iconRows(s, 2, 0) :
+		   KniwwelinoIconError_invalid_icon_string();
+}
+
+#define MATRIX_ICON(s) ((uint32_t) ::kniwwelino_detail::IconConst<::kniwwelinoIcon(s, sizeof(s) - 1)>::value)
+
+constexpr uint32_t operator"" _icon(const char* s, size_t len) {
+	return kniwwelinoIcon(s, len);
+}
+
 #endif
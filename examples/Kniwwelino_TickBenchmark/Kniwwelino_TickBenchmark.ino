@@ -0,0 +1,104 @@
+/***************************************************
+
+  Kniwwelino Tick Benchmark
+
+  Copyright (C) 2017 Luxembourg Institute of Science and Technology.
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the Lesser General Public License as published
+  by the Free Software Foundation, either version 3 of the License.
+
+  Example sketch to measure the cost of the background tick and of the
+  most used matrix and MQTT functions.
+
+  The background ticker is stopped and the tick is driven by the sketch.
+  The tick only queues the matrix and button I2C transfers, sleep(0) does
+  them, so both are timed together.
+  For every function the average time per call (ns/op) and the change of
+  the free heap per call is printed to the serial port.
+  A tick has to stay well below 50ms (TICK_FREQ) to keep the board responsive.
+  The MQTT message handling and exact allocation counts are measured by
+  the host benchmark in extras/host.
+
+****************************************************/
+
+#include <Kniwwelino.h>
+
+#define RUNS_TICK   1000
+#define RUNS_CALL   2000
+
+uint32_t startCycles;
+uint32_t startHeap;
+
+void benchStart() {
+  yield();
+  startHeap = ESP.getFreeHeap();
+  startCycles = ESP.getCycleCount();
+}
+
+void benchEnd(const char name[], uint32_t runs) {
+  uint32_t cycles = ESP.getCycleCount() - startCycles;
+  int32_t heap = (int32_t) ESP.getFreeHeap() - (int32_t) startHeap;
+  float nsPerOp = (cycles * 1000.0) / ESP.getCpuFreqMHz() / runs;
+  Serial.printf("%-28s %10.0f ns/op %8.3f heap bytes/op\n", name, nsPerOp, ((float) -heap) / runs);
+}
+
+void setup() {
+  //Initialize the Kniwwelino Board
+  Kniwwelino.begin("Kniwwelino_TickBenchmark", false, true, false); // Wifi=false, Fastboot=true, MQTT logging false
+
+  // drive the background tick ourself
+  Kniwwelino.bgTickStop();
+  Serial.println();
+  Serial.println(F("=== Kniwwelino Tick Benchmark ==="));
+
+  // idle tick, matrix static
+  Kniwwelino.MATRIXdrawIcon(ICON_HEART);
+  benchStart();
+  for (uint32_t i = 0; i < RUNS_TICK; i++) {
+    Kniwwelino.bgTick();
+    Kniwwelino.sleep(0);
+  }
+  benchEnd("bgTick (icon)", RUNS_TICK);
+
+  // tick while scrolling a long text
+  Kniwwelino.MATRIXwrite(F("The quick brown fox jumps over the lazy dog 0123456789"));
+  benchStart();
+  for (uint32_t i = 0; i < RUNS_TICK; i++) {
+    Kniwwelino.bgTick();
+    Kniwwelino.sleep(0);
+  }
+  benchEnd("bgTick (text)", RUNS_TICK);
+
+  // same without any background I2C traffic -> pure CPU time
+  Kniwwelino.bgI2CStop();
+  benchStart();
+  for (uint32_t i = 0; i < RUNS_TICK; i++) Kniwwelino.bgTick();
+  benchEnd("bgTick (text, no I2C)", RUNS_TICK);
+  Kniwwelino.bgI2CStart();
+
+  String text = "Kniwwelino";
+  benchStart();
+  for (uint32_t i = 0; i < RUNS_CALL; i++) Kniwwelino.MATRIXwrite(text);
+  benchEnd("MATRIXwrite", RUNS_CALL);
+
+  benchStart();
+  for (uint32_t i = 0; i < RUNS_CALL; i++) Kniwwelino.MATRIXdrawIcon(ICON_SMILE);
+  benchEnd("MATRIXdrawIcon(uint32_t)", RUNS_CALL);
+
+  String icon = "B0101000000100010111000000";
+  benchStart();
+  for (uint32_t i = 0; i < RUNS_CALL; i++) Kniwwelino.MATRIXdrawIcon(icon);
+  benchEnd("MATRIXdrawIcon(String)", RUNS_CALL);
+
+  benchStart();
+  for (uint32_t i = 0; i < RUNS_CALL; i++) Kniwwelino.MATRIXdrawIcon("0x7008E828A0:0:2.5");
+  benchEnd("MATRIXdrawIcon(const char*)", RUNS_CALL);
+
+  Serial.println(F("=== done ==="));
+  Kniwwelino.bgTickStart();
+  Kniwwelino.MATRIXdrawIcon(ICON_CHECK);
+}
+
+void loop() {
+  Kniwwelino.loop(); // do background stuff...
+}
@@ -0,0 +1,180 @@
+/***************************************************
+
+  KniwwelinoLIB host benchmark
+
+  Copyright (C) 2017 Luxembourg Institute of Science and Technology.
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the Lesser General Public License as published
+  by the Free Software Foundation, either version 3 of the License.
+
+  Runs the background tick and the most used matrix and MQTT functions
+  of the library many times on the host and prints for each of them
+  the average time (ns/op) and the heap allocations per call.
+
+  The tick is followed by the bus work that loop() does on the board
+  (_WORKdrain), so both are timed together, as in the
+  Kniwwelino_TickBenchmark example.
+  Allocations are counted by replacing malloc/calloc/realloc, the
+  operator new of libstdc++ allocates through them as well.
+
+  usage: kniwwelino_bench [runs]   (default 1000000)
+
+****************************************************/
+
+#include <Kniwwelino.h>
+
+#include <chrono>
+
+//==== allocation counting ===================================================
+
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t n, size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+extern "C" void __libc_free(void* ptr);
+
+static bool allocCounting = false;
+static uint64_t allocCount = 0;
+static uint64_t allocBytes = 0;
+
+static inline void allocCounted(size_t size) {
+	if (!allocCounting) return;
+	allocCount++;
+	allocBytes += size;
+}
+
+extern "C" void* malloc(size_t size) {
+	allocCounted(size);
+	return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t n, size_t size) {
+	allocCounted(n * size);
+	return __libc_calloc(n, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size) {
+	if (size > 0) allocCounted(size);
+	return __libc_realloc(ptr, size);
+}
+
+extern "C" void free(void* ptr) {
+	__libc_free(ptr);
+}
+
+//==== access to the library internals =======================================
+
+struct KniwwelinoHostBench {
+	static void tick() {
+		KniwwelinoLib::_baseTick();
+		Kniwwelino._WORKdrain();
+	}
+
+	static void mqttReceived(char topic[], char payload[], int length) {
+		KniwwelinoLib::_MQTTmessageReceived(&Kniwwelino.mqtt, topic, payload, length);
+	}
+
+	// a broker connection without WiFi, so that the MQTT functions can be used
+	static void mqttConnect() {
+		Kniwwelino.mqtt.connect("bench");
+		Kniwwelino.mqttEnabled = true;
+		Kniwwelino.mqtt.onMessageAdvanced(KniwwelinoLib::_MQTTmessageReceived);
+	}
+};
+
+//==== benchmark =============================================================
+
+static uint32_t handlerCalls = 0;
+
+static void sensorHandler(const char topic[], const char payload[], unsigned int length) {
+	handlerCalls++;
+}
+
+template<typename F> static void bench(const char name[], uint32_t runs, F f) {
+	allocCount = 0;
+	allocBytes = 0;
+	allocCounting = true;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < runs; i++) f();
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	allocCounting = false;
+
+	double ns = std::chrono::duration<double, std::nano>(end - start).count();
+	printf("%-32s %10.1f ns/op %8.3f allocs/op %10.1f bytes/op\n", name, ns / runs,
+			(double) allocCount / runs, (double) allocBytes / runs);
+}
+
+int main(int argc, char* argv[]) {
+	uint32_t runs = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 1000000;
+	if (runs == 0) runs = 1;
+
+	Kniwwelino.begin("Kniwwelino_HostBench", false, true, false); // Wifi=false, Fastboot=true, MQTT logging false
+	KniwwelinoHostBench::mqttConnect();
+	Kniwwelino.MQTTconnectMATRIX();
+	if (!Kniwwelino.MQTTon("SENSOR/+/TEMP", sensorHandler)) {
+		fprintf(stderr, "MQTTon failed\n");
+		return 1;
+	}
+
+	printf("=== Kniwwelino host benchmark, %u runs ===\n", runs);
+
+	// idle tick, matrix static
+	Kniwwelino.MATRIXdrawIcon(ICON_HEART);
+	uint32_t sent = Wire.hostTransmissions;
+	KniwwelinoHostBench::tick();
+	if (Wire.hostTransmissions == sent || Wire.hostLastAddress != HT16K33_ADDRESS) {
+		fprintf(stderr, "icon not sent to the matrix\n");
+		return 1;
+	}
+	bench("_baseTick (icon)", runs, KniwwelinoHostBench::tick);
+
+	// tick while scrolling a long text
+	Kniwwelino.MATRIXwrite(F("The quick brown fox jumps over the lazy dog 0123456789"));
+	bench("_baseTick (text)", runs, KniwwelinoHostBench::tick);
+	// same without any background I2C traffic -> pure CPU time
+	Kniwwelino.bgI2CStop();
+	bench("_baseTick (text, no I2C)", runs, KniwwelinoHostBench::tick);
+	Kniwwelino.bgI2CStart();
+
+	String text = "Kniwwelino";
+	bench("MATRIXwrite", runs, [&]() { Kniwwelino.MATRIXwrite(text); });
+
+	bench("MATRIXdrawIcon(uint32_t)", runs, []() { Kniwwelino.MATRIXdrawIcon(ICON_SMILE); });
+
+	String icon = "B0101000000100010111000000";
+	bench("MATRIXdrawIcon(String)", runs, [&]() { Kniwwelino.MATRIXdrawIcon(icon); });
+
+	bench("MATRIXdrawIcon(const char*)", runs, []() { Kniwwelino.MATRIXdrawIcon("0x7008E828A0:0:2.5"); });
+
+	// only the first icon is parsed, the other lines must not cost anything
+	const char icons[] = "0x7008E828A0:0:0.5\n0x0A1F1F0E04:0:0.5\n0x7008E828A0:0:0.5\n0x0A1F1F0E04:0:0.5";
+	bench("MATRIXdrawIcon(4 lines)", runs, [&]() { Kniwwelino.MATRIXdrawIcon(icons); });
+	String iconLines = icons;
+	bench("MATRIXplayIcons(4 lines)", runs, [&]() { Kniwwelino.MATRIXplayIcons(iconLines, 1); });
+	Kniwwelino.MATRIXclear();
+
+	// messages as the MQTT client hands them over, in its own buffers
+	char iconTopic[] = "kniwwelino/MATRIX/ICON";
+	char iconPayload[] = "B0101010101100010101000100";
+	bench("_MQTTmessageReceived (ICON)", runs, [&]() {
+		KniwwelinoHostBench::mqttReceived(iconTopic, iconPayload, sizeof(iconPayload) - 1);
+	});
+
+	char sensorTopic[] = "kniwwelino/SENSOR/kitchen/TEMP";
+	char sensorPayload[] = "21.5";
+	bench("_MQTTmessageReceived (MQTTon)", runs, [&]() {
+		KniwwelinoHostBench::mqttReceived(sensorTopic, sensorPayload, sizeof(sensorPayload) - 1);
+	});
+
+	char otherTopic[] = "kniwwelino/OTHER/TOPIC";
+	char otherPayload[] = "1";
+	bench("_MQTTmessageReceived (no route)", runs, [&]() {
+		KniwwelinoHostBench::mqttReceived(otherTopic, otherPayload, sizeof(otherPayload) - 1);
+	});
+
+	if (handlerCalls != runs) {
+		fprintf(stderr, "MQTTon handler called %u times, expected %u\n", handlerCalls, runs);
+		return 1;
+	}
+	printf("=== done ===\n");
+	return 0;
+}
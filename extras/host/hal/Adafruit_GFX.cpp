@@ -0,0 +1,262 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the Adafruit GFX library v1.2.2, see Adafruit_GFX.h.
+
+ ****************************************************/
+#include "Adafruit_GFX.h"
+
+#define _swap_int16_t(a, b) { int16_t t = a; a = b; b = t; }
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
+	_width = WIDTH;
+	_height = HEIGHT;
+	rotation = 0;
+	cursor_y = cursor_x = 0;
+	textsize = 1;
+	textcolor = textbgcolor = 0xFFFF;
+	wrap = true;
+	gfxFont = nullptr;
+}
+
+void Adafruit_GFX::startWrite() {
+}
+
+void Adafruit_GFX::writePixel(int16_t x, int16_t y, uint16_t color) {
+	drawPixel(x, y, color);
+}
+
+void Adafruit_GFX::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+	fillRect(x, y, w, h, color);
+}
+
+void Adafruit_GFX::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+	drawFastVLine(x, y, h, color);
+}
+
+void Adafruit_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+	drawFastHLine(x, y, w, color);
+}
+
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+	int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+	if (steep) {
+		_swap_int16_t(x0, y0);
+		_swap_int16_t(x1, y1);
+	}
+	if (x0 > x1) {
+		_swap_int16_t(x0, x1);
+		_swap_int16_t(y0, y1);
+	}
+
+	int16_t dx = x1 - x0;
+	int16_t dy = abs(y1 - y0);
+	int16_t err = dx / 2;
+	int16_t ystep = (y0 < y1) ? 1 : -1;
+
+	for (; x0 <= x1; x0++) {
+		if (steep) {
+			writePixel(y0, x0, color);
+		} else {
+			writePixel(x0, y0, color);
+		}
+		err -= dy;
+		if (err < 0) {
+			y0 += ystep;
+			err += dx;
+		}
+	}
+}
+
+void Adafruit_GFX::endWrite() {
+}
+
+void Adafruit_GFX::setRotation(uint8_t x) {
+	rotation = (x & 3);
+	switch (rotation) {
+	case 0:
+	case 2:
+		_width = WIDTH;
+		_height = HEIGHT;
+		break;
+	case 1:
+	case 3:
+		_width = HEIGHT;
+		_height = WIDTH;
+		break;
+	}
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+	startWrite();
+	writeLine(x, y, x, y + h - 1, color);
+	endWrite();
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+	startWrite();
+	writeLine(x, y, x + w - 1, y, color);
+	endWrite();
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+	startWrite();
+	for (int16_t i = x; i < x + w; i++) {
+		writeFastVLine(i, y, h, color);
+	}
+	endWrite();
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) {
+	fillRect(0, 0, _width, _height, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+	if (x0 == x1) {
+		if (y0 > y1) _swap_int16_t(y0, y1);
+		drawFastVLine(x0, y0, y1 - y0 + 1, color);
+	} else if (y0 == y1) {
+		if (x0 > x1) _swap_int16_t(x0, x1);
+		drawFastHLine(x0, y0, x1 - x0 + 1, color);
+	} else {
+		startWrite();
+		writeLine(x0, y0, x1, y1, color);
+		endWrite();
+	}
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+	startWrite();
+	writeFastHLine(x, y, w, color);
+	writeFastHLine(x, y + h - 1, w, color);
+	writeFastVLine(x, y, h, color);
+	writeFastVLine(x + w - 1, y, h, color);
+	endWrite();
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+	// the classic font is not part of the host build
+	if (gfxFont == nullptr) return;
+
+	c -= gfxFont->first;
+	GFXglyph *glyph = &gfxFont->glyph[c];
+	uint8_t *bitmap = gfxFont->bitmap;
+
+	uint16_t bo = glyph->bitmapOffset;
+	uint8_t w = glyph->width, h = glyph->height;
+	int8_t xo = glyph->xOffset, yo = glyph->yOffset;
+	uint8_t xx, yy, bits = 0, bit = 0;
+	int16_t xo16 = 0, yo16 = 0;
+
+	if (size > 1) {
+		xo16 = xo;
+		yo16 = yo;
+	}
+
+	startWrite();
+	for (yy = 0; yy < h; yy++) {
+		for (xx = 0; xx < w; xx++) {
+			if (!(bit++ & 7)) {
+				bits = bitmap[bo++];
+			}
+			if (bits & 0x80) {
+				if (size == 1) {
+					writePixel(x + xo + xx, y + yo + yy, color);
+				} else {
+					writeFillRect(x + (xo16 + xx) * size, y + (yo16 + yy) * size, size, size, color);
+				}
+			}
+			bits <<= 1;
+		}
+	}
+	endWrite();
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+	if (gfxFont == nullptr) {
+		// classic 6x8 cell, nothing drawn
+		if (c == '\n') {
+			cursor_y += textsize * 8;
+			cursor_x = 0;
+		} else if (c != '\r') {
+			cursor_x += textsize * 6;
+		}
+		return 1;
+	}
+
+	if (c == '\n') {
+		cursor_x = 0;
+		cursor_y += (int16_t) textsize * gfxFont->yAdvance;
+	} else if (c != '\r') {
+		uint8_t first = gfxFont->first;
+		if ((c >= first) && (c <= gfxFont->last)) {
+			GFXglyph *glyph = &gfxFont->glyph[c - first];
+			uint8_t w = glyph->width, h = glyph->height;
+			if ((w > 0) && (h > 0)) {
+				int16_t xo = glyph->xOffset;
+				if (wrap && ((cursor_x + textsize * (xo + w)) > _width)) {
+					cursor_x = 0;
+					cursor_y += (int16_t) textsize * gfxFont->yAdvance;
+				}
+				drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize);
+			}
+			cursor_x += glyph->xAdvance * (int16_t) textsize;
+		}
+	}
+	return 1;
+}
+
+void Adafruit_GFX::setCursor(int16_t x, int16_t y) {
+	cursor_x = x;
+	cursor_y = y;
+}
+
+int16_t Adafruit_GFX::getCursorX(void) const {
+	return cursor_x;
+}
+
+int16_t Adafruit_GFX::getCursorY(void) const {
+	return cursor_y;
+}
+
+void Adafruit_GFX::setTextSize(uint8_t s) {
+	textsize = (s > 0) ? s : 1;
+}
+
+void Adafruit_GFX::setTextColor(uint16_t c) {
+	textcolor = textbgcolor = c;
+}
+
+void Adafruit_GFX::setTextColor(uint16_t c, uint16_t b) {
+	textcolor = c;
+	textbgcolor = b;
+}
+
+void Adafruit_GFX::setTextWrap(boolean w) {
+	wrap = w;
+}
+
+uint8_t Adafruit_GFX::getRotation(void) const {
+	return rotation;
+}
+
+void Adafruit_GFX::setFont(const GFXfont *f) {
+	if (f) {
+		if (!gfxFont) {
+			// the custom fonts have their baseline at the cursor
+			cursor_y += 6;
+		}
+	} else if (gfxFont) {
+		cursor_y -= 6;
+	}
+	gfxFont = (GFXfont *) f;
+}
+
+int16_t Adafruit_GFX::width(void) const {
+	return _width;
+}
+
+int16_t Adafruit_GFX::height(void) const {
+	return _height;
+}
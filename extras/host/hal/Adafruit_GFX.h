@@ -0,0 +1,66 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the Adafruit GFX library v1.2.2, with the drawing and the
+  custom font text output used by the library. The classic built-in
+  font is not included, text without setFont() only moves the cursor.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_Adafruit_GFX_h
+#define KniwwelinoHost_Adafruit_GFX_h
+
+#include "Arduino.h"
+#include "gfxfont.h"
+
+class Adafruit_GFX : public Print {
+	public:
+		Adafruit_GFX(int16_t w, int16_t h);
+
+		virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+		virtual void startWrite(void);
+		virtual void writePixel(int16_t x, int16_t y, uint16_t color);
+		virtual void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+		virtual void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+		virtual void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+		virtual void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+		virtual void endWrite(void);
+
+		virtual void setRotation(uint8_t r);
+		virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+		virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+		virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+		virtual void fillScreen(uint16_t color);
+		virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+		virtual void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+		void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+		void setCursor(int16_t x, int16_t y);
+		void setTextColor(uint16_t c);
+		void setTextColor(uint16_t c, uint16_t bg);
+		void setTextSize(uint8_t s);
+		void setTextWrap(boolean w);
+		void setFont(const GFXfont *f = nullptr);
+
+		virtual size_t write(uint8_t c) override;
+		using Print::write;
+
+		int16_t height(void) const;
+		int16_t width(void) const;
+		uint8_t getRotation(void) const;
+		int16_t getCursorX(void) const;
+		int16_t getCursorY(void) const;
+
+	protected:
+		const int16_t WIDTH, HEIGHT;
+		int16_t _width, _height;
+		int16_t cursor_x, cursor_y;
+		uint16_t textcolor, textbgcolor;
+		uint8_t textsize;
+		uint8_t rotation;
+		boolean wrap;
+		GFXfont *gfxFont;
+};
+
+#endif
@@ -0,0 +1,113 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the Adafruit NeoPixel library, see Adafruit_NeoPixel.h.
+
+ ****************************************************/
+#include "Adafruit_NeoPixel.h"
+
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t n, uint8_t p, neoPixelType t) : numLEDs(n), pin(p) {
+	pixels = (uint8_t *) calloc(n * 3, 1);
+	if (pixels == nullptr) numLEDs = 0;
+}
+
+Adafruit_NeoPixel::Adafruit_NeoPixel() {
+}
+
+Adafruit_NeoPixel::Adafruit_NeoPixel(const Adafruit_NeoPixel &other) {
+	*this = other;
+}
+
+Adafruit_NeoPixel & Adafruit_NeoPixel::operator =(const Adafruit_NeoPixel &other) {
+	if (this == &other) return *this;
+	free(pixels);
+	numLEDs = other.numLEDs;
+	brightness = other.brightness;
+	pin = other.pin;
+	pixels = nullptr;
+	if (numLEDs > 0) {
+		pixels = (uint8_t *) malloc(numLEDs * 3);
+		memcpy(pixels, other.pixels, numLEDs * 3);
+	}
+	return *this;
+}
+
+Adafruit_NeoPixel::~Adafruit_NeoPixel() {
+	free(pixels);
+}
+
+void Adafruit_NeoPixel::begin() {
+	pinMode(pin, OUTPUT);
+}
+
+void Adafruit_NeoPixel::show() {
+	hostShows++;
+}
+
+void Adafruit_NeoPixel::setPin(uint8_t p) {
+	pin = p;
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b) {
+	if (n >= numLEDs) return;
+	if (brightness) {
+		r = (r * brightness) >> 8;
+		g = (g * brightness) >> 8;
+		b = (b * brightness) >> 8;
+	}
+	uint8_t *p = &pixels[n * 3];
+	p[0] = r;
+	p[1] = g;
+	p[2] = b;
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint32_t c) {
+	setPixelColor(n, (uint8_t)(c >> 16), (uint8_t)(c >> 8), (uint8_t) c);
+}
+
+void Adafruit_NeoPixel::setBrightness(uint8_t b) {
+	// stored as 1-256 like the original, 0 = full brightness
+	uint8_t newBrightness = b + 1;
+	if (newBrightness == brightness) return;
+	uint8_t oldBrightness = brightness - 1;
+	uint16_t scale;
+	if (oldBrightness == 0) scale = 0;
+	else if (b == 255) scale = 65535 / oldBrightness;
+	else scale = (((uint16_t) newBrightness << 8) - 1) / oldBrightness;
+	for (uint16_t i = 0; i < numLEDs * 3; i++) {
+		pixels[i] = (pixels[i] * scale) >> 8;
+	}
+	brightness = newBrightness;
+}
+
+void Adafruit_NeoPixel::clear() {
+	if (pixels) memset(pixels, 0, numLEDs * 3);
+}
+
+uint8_t* Adafruit_NeoPixel::getPixels() const {
+	return pixels;
+}
+
+uint8_t Adafruit_NeoPixel::getBrightness() const {
+	return brightness - 1;
+}
+
+uint16_t Adafruit_NeoPixel::numPixels() const {
+	return numLEDs;
+}
+
+uint32_t Adafruit_NeoPixel::getPixelColor(uint16_t n) const {
+	if (n >= numLEDs) return 0;
+	const uint8_t *p = &pixels[n * 3];
+	if (brightness) {
+		return (((uint32_t)(p[0] << 8) / brightness) << 16) |
+			   (((uint32_t)(p[1] << 8) / brightness) << 8) |
+			   ((uint32_t)(p[2] << 8) / brightness);
+	}
+	return ((uint32_t) p[0] << 16) | ((uint32_t) p[1] << 8) | p[2];
+}
+
+uint32_t Adafruit_NeoPixel::Color(uint8_t r, uint8_t g, uint8_t b) {
+	return ((uint32_t) r << 16) | ((uint32_t) g << 8) | b;
+}
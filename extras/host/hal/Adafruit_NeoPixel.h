@@ -0,0 +1,50 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the Adafruit NeoPixel library, the pixels are kept in RAM.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_Adafruit_NeoPixel_h
+#define KniwwelinoHost_Adafruit_NeoPixel_h
+
+#include "Arduino.h"
+
+#define NEO_RGB 		((0 << 6) | (0 << 4) | (1 << 2) | (2))
+#define NEO_GRB 		((1 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_KHZ800 		0x0000
+#define NEO_KHZ400 		0x0100
+
+typedef uint16_t neoPixelType;
+
+class Adafruit_NeoPixel {
+	public:
+		Adafruit_NeoPixel(uint16_t n, uint8_t p = 6, neoPixelType t = NEO_GRB + NEO_KHZ800);
+		Adafruit_NeoPixel();
+		Adafruit_NeoPixel(const Adafruit_NeoPixel &other);
+		Adafruit_NeoPixel & operator =(const Adafruit_NeoPixel &other);
+		~Adafruit_NeoPixel();
+
+		void begin();
+		void show();
+		void setPin(uint8_t p);
+		void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b);
+		void setPixelColor(uint16_t n, uint32_t c);
+		void setBrightness(uint8_t b);
+		void clear();
+		uint8_t* getPixels() const;
+		uint8_t getBrightness() const;
+		uint16_t numPixels() const;
+		uint32_t getPixelColor(uint16_t n) const;
+		static uint32_t Color(uint8_t r, uint8_t g, uint8_t b);
+
+		uint32_t hostShows = 0;		// host only: calls of show()
+
+	private:
+		uint16_t numLEDs = 0;
+		uint8_t *pixels = nullptr;	// RGB order, scaled by the brightness
+		uint8_t brightness = 0;
+		uint8_t pin = 0;
+};
+
+#endif
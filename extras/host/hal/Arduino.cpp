@@ -0,0 +1,191 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the ESP8266 Arduino core functions.
+
+ ****************************************************/
+#include "Arduino.h"
+
+#include <time.h>
+
+uint8_t hostPinLevel[18];
+uint16_t hostAnalogValue = 0;
+
+volatile uint32_t GPOS = 0;
+volatile uint32_t GPOC = 0;
+volatile uint32_t GP16O = 0;
+
+HardwareSerial Serial;
+EspClass ESP;
+
+//==== time ==================================================================
+
+static uint64_t hostNanos() {
+	static uint64_t start = 0;
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	uint64_t now = (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+	if (start == 0) start = now;
+	return now - start;
+}
+
+unsigned long millis() {
+	return (unsigned long)(uint32_t)(hostNanos() / 1000000ULL);
+}
+
+unsigned long micros() {
+	return (unsigned long)(uint32_t)(hostNanos() / 1000ULL);
+}
+
+void delay(unsigned long ms) {
+	struct timespec ts = { (time_t)(ms / 1000), (long)(ms % 1000) * 1000000L };
+	nanosleep(&ts, nullptr);
+}
+
+void delayMicroseconds(unsigned int us) {
+	struct timespec ts = { (time_t)(us / 1000000), (long)(us % 1000000) * 1000L };
+	nanosleep(&ts, nullptr);
+}
+
+void yield() {
+}
+
+//==== pins ==================================================================
+
+void pinMode(uint8_t pin, uint8_t mode) {
+	if (pin < sizeof(hostPinLevel) && mode == INPUT_PULLUP) hostPinLevel[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+	if (pin < sizeof(hostPinLevel)) hostPinLevel[pin] = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+	return pin < sizeof(hostPinLevel) ? hostPinLevel[pin] : LOW;
+}
+
+int analogRead(uint8_t pin) {
+	return hostAnalogValue;
+}
+
+void analogWrite(uint8_t pin, int val) {
+	if (pin < sizeof(hostPinLevel)) hostPinLevel[pin] = val > 0 ? HIGH : LOW;
+}
+
+void analogWriteFreq(uint32_t freq) {
+}
+
+void analogWriteRange(uint32_t range) {
+}
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration) {
+}
+
+void noTone(uint8_t pin) {
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(), int mode) {
+}
+
+void detachInterrupt(uint8_t pin) {
+}
+
+void noInterrupts() {
+}
+
+void interrupts() {
+}
+
+uint32_t xt_rsil(uint32_t level) {
+	return 0;
+}
+
+void xt_wsr_ps(uint32_t state) {
+}
+
+//==== math ==================================================================
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+	return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+long random(long howbig) {
+	if (howbig == 0) return 0;
+	return rand() % howbig;
+}
+
+long random(long howsmall, long howbig) {
+	if (howsmall >= howbig) return howsmall;
+	return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+	if (seed != 0) srand(seed);
+}
+
+//==== Serial ================================================================
+
+void HardwareSerial::begin(unsigned long baud) {
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+	if (echo) putchar(c);
+	return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+	if (echo) fwrite(buffer, 1, size, stdout);
+	return size;
+}
+
+int HardwareSerial::available() {
+	return 0;
+}
+
+int HardwareSerial::read() {
+	return -1;
+}
+
+int HardwareSerial::peek() {
+	return -1;
+}
+
+//==== ESP ===================================================================
+
+String EspClass::getResetReason() {
+	return String("Power on");
+}
+
+uint32_t EspClass::getCycleCount() {
+	// CPU cycles at 80 MHz
+	return (uint32_t)(hostNanos() * 80 / 1000);
+}
+
+uint8_t EspClass::getCpuFreqMHz() {
+	return 80;
+}
+
+uint32_t EspClass::getFreeHeap() {
+	return 40000;
+}
+
+void EspClass::restart() {
+	exit(0);
+}
+
+uint32_t EspClass::getFreeSketchSpace() {
+	return 1024 * 1024;
+}
+
+uint32_t EspClass::getSketchSize() {
+	return 400 * 1024;
+}
+
+uint32_t EspClass::getFlashChipRealSize() {
+	return 4 * 1024 * 1024;
+}
+
+const char* EspClass::getSdkVersion() {
+	return "host";
+}
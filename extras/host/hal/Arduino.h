@@ -0,0 +1,148 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the ESP8266 Arduino core, just enough to compile and run
+  the library on a Linux host. Time is taken from the host clock, pins
+  and registers are plain variables.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_Arduino_h
+#define KniwwelinoHost_Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+
+#include <type_traits>
+
+#include "WString.h"
+#include "Print.h"
+
+typedef uint8_t boolean;		// as in the ESP8266 core 2.4
+typedef uint8_t byte;
+
+#define HIGH 			0x1
+#define LOW  			0x0
+
+#define INPUT 			0x00
+#define INPUT_PULLUP 	0x02
+#define OUTPUT 			0x01
+
+#define RISING 			0x01
+#define FALLING 		0x02
+#define CHANGE 			0x03
+
+// Wemos D1 mini pins
+#define D0 				16
+#define D1 				5
+#define D2 				4
+#define D3 				0
+#define D4 				2
+#define D5 				14
+#define D6 				12
+#define D7 				13
+#define D8 				15
+#define A0 				17
+
+#define PWMRANGE 		1023
+#define F_CPU 			80000000L
+
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define PSTR(s) 		(s)
+#define FPSTR(p) 		(reinterpret_cast<const __FlashStringHelper*>(p))
+#define F(s) 			(reinterpret_cast<const __FlashStringHelper*>(PSTR(s)))
+
+#define pgm_read_byte(addr) 	(*(const uint8_t*)(addr))
+#define pgm_read_word(addr) 	(*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) 	(*(const uint32_t*)(addr))
+#define strlen_P 				strlen
+#define strncasecmp_P 			strncasecmp
+#define memcpy_P 				memcpy
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define bit(b) 					(1UL << (b))
+#define bitRead(value, bit) 	(((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) 		((value) |= (1UL << (bit)))
+#define bitClear(value, bit) 	((value) &= ~(1UL << (bit)))
+#define digitalPinToInterrupt(p) (((p) < 16) ? (p) : NOT_AN_INTERRUPT)
+#define NOT_AN_INTERRUPT 		-1
+
+template<typename A, typename B> inline typename std::common_type<A, B>::type min(A a, B b) { return a < b ? a : b; }
+template<typename A, typename B> inline typename std::common_type<A, B>::type max(A a, B b) { return a < b ? b : a; }
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+void analogWriteFreq(uint32_t freq);
+void analogWriteRange(uint32_t range);
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration = 0);
+void noTone(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*handler)(), int mode);
+void detachInterrupt(uint8_t pin);
+
+void noInterrupts();
+void interrupts();
+uint32_t xt_rsil(uint32_t level);
+void xt_wsr_ps(uint32_t state);
+
+// GPIO set/clear registers and GPIO16 output register
+extern volatile uint32_t GPOS;
+extern volatile uint32_t GPOC;
+extern volatile uint32_t GP16O;
+
+/*
+ * host pins, set by the test or benchmark to simulate inputs.
+ */
+extern uint8_t hostPinLevel[18];
+extern uint16_t hostAnalogValue;
+
+class HardwareSerial : public Stream {
+	public:
+		void begin(unsigned long baud);
+		size_t write(uint8_t c) override;
+		size_t write(const uint8_t *buffer, size_t size) override;
+		int available() override;
+		int read() override;
+		int peek() override;
+
+		// serial output goes to stdout if true, is dropped otherwise
+		boolean echo = false;
+};
+
+extern HardwareSerial Serial;
+
+class EspClass {
+	public:
+		String getResetReason();
+		uint32_t getCycleCount();
+		uint8_t getCpuFreqMHz();
+		uint32_t getFreeHeap();
+		void restart();
+		uint32_t getFreeSketchSpace();
+		uint32_t getSketchSize();
+		uint32_t getFlashChipRealSize();
+		const char* getSdkVersion();
+};
+
+extern EspClass ESP;
+
+#endif
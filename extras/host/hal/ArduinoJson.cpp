@@ -0,0 +1,77 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for ArduinoJson v5, see ArduinoJson.h.
+
+ ****************************************************/
+#include "ArduinoJson.h"
+
+#include <ctype.h>
+
+JsonVariant JsonObject::operator [](const char key[]) const {
+	std::map<std::string, std::string>::const_iterator it = values.find(key);
+	return JsonVariant(it == values.end() ? nullptr : &it->second);
+}
+
+bool JsonObject::set(const String &key, const String &value) {
+	values[key.c_str()] = value.c_str();
+	return true;
+}
+
+size_t JsonObject::printTo(Print &out) const {
+	size_t n = out.print('{');
+	for (std::map<std::string, std::string>::const_iterator it = values.begin(); it != values.end(); ++it) {
+		if (it != values.begin()) n += out.print(',');
+		n += out.print('"');
+		n += out.print(it->first.c_str());
+		n += out.print("\":\"");
+		n += out.print(it->second.c_str());
+		n += out.print('"');
+	}
+	return n + out.print('}');
+}
+
+/*
+ * parses {"key":"value","key":123,...}, nested objects and arrays are not supported.
+ */
+bool JsonObject::parse(const char* s) {
+	values.clear();
+	while (isspace(*s)) s++;
+	if (*s++ != '{') return false;
+	while (true) {
+		while (isspace(*s) || *s == ',') s++;
+		if (*s == '}') return true;
+		if (*s++ != '"') return false;
+		std::string key;
+		while (*s && *s != '"') key += *s++;
+		if (*s++ != '"') return false;
+		while (isspace(*s)) s++;
+		if (*s++ != ':') return false;
+		while (isspace(*s)) s++;
+		std::string value;
+		if (*s == '"') {
+			s++;
+			while (*s && *s != '"') {
+				if (*s == '\\' && s[1]) s++;
+				value += *s++;
+			}
+			if (*s++ != '"') return false;
+		} else {
+			while (*s && *s != ',' && *s != '}' && !isspace(*s)) value += *s++;
+			if (value.empty()) return false;
+		}
+		values[key] = value;
+	}
+}
+
+JsonObject& DynamicJsonBuffer::createObject() {
+	objects.push_back(JsonObject());
+	return objects.back();
+}
+
+JsonObject& DynamicJsonBuffer::parseObject(const String &json) {
+	JsonObject &object = createObject();
+	object.valid = object.parse(json.c_str());
+	return object;
+}
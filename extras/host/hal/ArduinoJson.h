@@ -0,0 +1,54 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for ArduinoJson v5, for flat objects with string and number
+  values, as used for the platform configuration.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_ArduinoJson_h
+#define KniwwelinoHost_ArduinoJson_h
+
+#include "Arduino.h"
+
+#include <list>
+#include <map>
+#include <string>
+
+class JsonVariant {
+	public:
+		explicit JsonVariant(const std::string *value) : value(value) {}
+		operator const char*() const { return value ? value->c_str() : nullptr; }
+		operator int() const { return value ? atoi(value->c_str()) : 0; }
+		operator long() const { return value ? atol(value->c_str()) : 0; }
+
+	private:
+		const std::string *value;
+};
+
+class JsonObject {
+	public:
+		bool success() const { return valid; }
+		bool containsKey(const char key[]) const { return values.count(key) > 0; }
+		JsonVariant operator [](const char key[]) const;
+		bool set(const String &key, const String &value);
+		size_t printTo(Print &out) const;
+
+	private:
+		friend class DynamicJsonBuffer;
+		bool parse(const char* json);
+
+		std::map<std::string, std::string> values;
+		bool valid = true;
+};
+
+class DynamicJsonBuffer {
+	public:
+		JsonObject& createObject();
+		JsonObject& parseObject(const String &json);
+
+	private:
+		std::list<JsonObject> objects;
+};
+
+#endif
@@ -0,0 +1,11 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the DNSServer library, only used by WiFiManager.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_DNSServer_h
+#define KniwwelinoHost_DNSServer_h
+
+#endif
@@ -0,0 +1,34 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the EEPROM library, see EEPROM.h.
+
+ ****************************************************/
+#include "EEPROM.h"
+
+EEPROMClass EEPROM;
+
+void EEPROMClass::begin(size_t size) {
+	if (size > EEPROM_HOST_SIZE) size = EEPROM_HOST_SIZE;
+	if (this->size == 0) memset(data, 0xFF, sizeof(data));
+	this->size = size;
+}
+
+uint8_t EEPROMClass::read(int address) {
+	if (address < 0 || (size_t) address >= size) return 0;
+	return data[address];
+}
+
+void EEPROMClass::write(int address, uint8_t val) {
+	if (address < 0 || (size_t) address >= size) return;
+	data[address] = val;
+}
+
+bool EEPROMClass::commit() {
+	return size > 0;
+}
+
+void EEPROMClass::end() {
+	size = 0;
+}
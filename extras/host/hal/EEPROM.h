@@ -0,0 +1,30 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the EEPROM library, kept in RAM.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_EEPROM_h
+#define KniwwelinoHost_EEPROM_h
+
+#include "Arduino.h"
+
+#define EEPROM_HOST_SIZE 4096
+
+class EEPROMClass {
+	public:
+		void begin(size_t size);
+		uint8_t read(int address);
+		void write(int address, uint8_t val);
+		bool commit();
+		void end();
+
+	private:
+		uint8_t data[EEPROM_HOST_SIZE];
+		size_t size = 0;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,27 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the ESP8266HTTPClient library, every request fails.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_ESP8266HTTPClient_h
+#define KniwwelinoHost_ESP8266HTTPClient_h
+
+#include "Arduino.h"
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+
+class HTTPClient {
+	public:
+		bool begin(String host, uint16_t port, String uri = "/") { return true; }
+		void end() {}
+		void useHTTP10(bool usehttp10 = true) {}
+		void setTimeout(uint16_t timeout) {}
+		void setUserAgent(const String &userAgent) {}
+		void addHeader(const String &name, const String &value, bool first = false, bool replace = true) {}
+		int POST(String payload) { return HTTPC_ERROR_CONNECTION_REFUSED; }
+		String getString() { return String(); }
+};
+
+#endif
@@ -0,0 +1,11 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the ESP8266WebServer library, only used by WiFiManager.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_ESP8266WebServer_h
+#define KniwwelinoHost_ESP8266WebServer_h
+
+#endif
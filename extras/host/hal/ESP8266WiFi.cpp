@@ -0,0 +1,87 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-ins for the ESP8266WiFi and ESP8266httpUpdate libraries.
+
+ ****************************************************/
+#include "ESP8266WiFi.h"
+#include "ESP8266httpUpdate.h"
+
+ESP8266WiFiClass WiFi;
+ESP8266HTTPUpdate ESPhttpUpdate;
+
+String IPAddress::toString() const {
+	char buf[16];
+	snprintf(buf, sizeof(buf), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+	return String(buf);
+}
+
+wl_status_t ESP8266WiFiClass::begin() {
+	return hostStatus;
+}
+
+wl_status_t ESP8266WiFiClass::begin(const char* ssid, const char *passphrase) {
+	return hostStatus;
+}
+
+bool ESP8266WiFiClass::disconnect(bool wifioff) {
+	return true;
+}
+
+bool ESP8266WiFiClass::mode(WiFiMode_t mode) {
+	return true;
+}
+
+wl_status_t ESP8266WiFiClass::status() {
+	return hostStatus;
+}
+
+bool ESP8266WiFiClass::hostname(const String &name) {
+	return true;
+}
+
+String ESP8266WiFiClass::macAddress() {
+	return String("5C:CF:7F:00:00:01");
+}
+
+String ESP8266WiFiClass::softAPmacAddress() {
+	return String("5E:CF:7F:00:00:01");
+}
+
+IPAddress ESP8266WiFiClass::localIP() {
+	return hostStatus == WL_CONNECTED ? IPAddress(192, 168, 4, 2) : IPAddress();
+}
+
+IPAddress ESP8266WiFiClass::gatewayIP() {
+	return hostStatus == WL_CONNECTED ? IPAddress(192, 168, 4, 1) : IPAddress();
+}
+
+IPAddress ESP8266WiFiClass::dnsIP(uint8_t dns_no) {
+	return gatewayIP();
+}
+
+String ESP8266WiFiClass::SSID() const {
+	return String();
+}
+
+String ESP8266WiFiClass::SSID(uint8_t networkItem) {
+	return String();
+}
+
+String ESP8266WiFiClass::psk() const {
+	return String();
+}
+
+int8_t ESP8266WiFiClass::scanNetworks() {
+	return 0;
+}
+
+int32_t ESP8266WiFiClass::RSSI(uint8_t networkItem) {
+	return 0;
+}
+
+int ESP8266WiFiClass::hostByName(const char* aHostname, IPAddress& aResult) {
+	aResult = IPAddress();
+	return 0;
+}
@@ -0,0 +1,75 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the ESP8266WiFi library. The host has no network, the
+  station stays disconnected unless a test sets hostStatus.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_ESP8266WiFi_h
+#define KniwwelinoHost_ESP8266WiFi_h
+
+#include "Arduino.h"
+
+typedef enum {
+	WL_IDLE_STATUS 		= 0,
+	WL_NO_SSID_AVAIL 	= 1,
+	WL_SCAN_COMPLETED 	= 2,
+	WL_CONNECTED 		= 3,
+	WL_CONNECT_FAILED 	= 4,
+	WL_CONNECTION_LOST 	= 5,
+	WL_DISCONNECTED 	= 6
+} wl_status_t;
+
+typedef enum WiFiMode {
+	WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3
+} WiFiMode_t;
+
+class IPAddress {
+	public:
+		IPAddress() {}
+		IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : bytes { a, b, c, d } {}
+		uint8_t operator [](int index) const { return bytes[index]; }
+		String toString() const;
+
+	private:
+		uint8_t bytes[4] = { 0, 0, 0, 0 };
+};
+
+class Client : public Stream {
+	public:
+		size_t write(uint8_t c) override { return 0; }
+		int available() override { return 0; }
+		int read() override { return -1; }
+		int peek() override { return -1; }
+};
+
+class WiFiClient : public Client {
+};
+
+class ESP8266WiFiClass {
+	public:
+		wl_status_t begin();
+		wl_status_t begin(const char* ssid, const char *passphrase = nullptr);
+		bool disconnect(bool wifioff = false);
+		bool mode(WiFiMode_t mode);
+		wl_status_t status();
+		bool hostname(const String &name);
+		String macAddress();
+		String softAPmacAddress();
+		IPAddress localIP();
+		IPAddress gatewayIP();
+		IPAddress dnsIP(uint8_t dns_no = 0);
+		String SSID() const;
+		String SSID(uint8_t networkItem);
+		String psk() const;
+		int8_t scanNetworks();
+		int32_t RSSI(uint8_t networkItem);
+		int hostByName(const char* aHostname, IPAddress& aResult);
+
+		wl_status_t hostStatus = WL_DISCONNECTED;	// host only
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,32 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the ESP8266httpUpdate library, every update fails.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_ESP8266httpUpdate_h
+#define KniwwelinoHost_ESP8266httpUpdate_h
+
+#include "Arduino.h"
+
+enum HTTPUpdateResult {
+	HTTP_UPDATE_FAILED,
+	HTTP_UPDATE_NO_UPDATES,
+	HTTP_UPDATE_OK
+};
+
+typedef HTTPUpdateResult t_httpUpdate_return;
+
+class ESP8266HTTPUpdate {
+	public:
+		t_httpUpdate_return update(const String &host, uint16_t port, const String &uri = "/", const String &currentVersion = "") {
+			return HTTP_UPDATE_FAILED;
+		}
+		int getLastError() { return -1; }
+		String getLastErrorString() { return String("no network on the host"); }
+};
+
+extern ESP8266HTTPUpdate ESPhttpUpdate;
+
+#endif
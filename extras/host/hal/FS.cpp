@@ -0,0 +1,80 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the SPIFFS file system, see FS.h.
+
+ ****************************************************/
+#include "FS.h"
+
+fs::FS SPIFFS;
+
+namespace fs {
+
+File::File(FileMap *files, const char *path, bool writing) : files(files), path(new std::string(path)), writing(writing) {
+	if (writing) (*files)[*this->path].clear();
+}
+
+size_t File::write(uint8_t c) {
+	return write(&c, 1);
+}
+
+size_t File::write(const uint8_t *buf, size_t size) {
+	if (files == nullptr || !writing) return 0;
+	(*files)[*path].append((const char*) buf, size);
+	return size;
+}
+
+int File::available() {
+	if (files == nullptr || writing) return 0;
+	return size() - pos;
+}
+
+int File::read() {
+	if (available() <= 0) return -1;
+	return (uint8_t) (*files)[*path][pos++];
+}
+
+int File::peek() {
+	if (available() <= 0) return -1;
+	return (uint8_t) (*files)[*path][pos];
+}
+
+size_t File::size() const {
+	if (files == nullptr) return 0;
+	FileMap::const_iterator it = files->find(*path);
+	return it == files->end() ? 0 : it->second.size();
+}
+
+void File::close() {
+	files = nullptr;
+	path.reset();
+}
+
+bool FS::begin() {
+	return true;
+}
+
+void FS::end() {
+}
+
+bool FS::format() {
+	files.clear();
+	return true;
+}
+
+bool FS::exists(const String &path) {
+	return files.count(path.c_str()) > 0;
+}
+
+File FS::open(const String &path, const char *mode) {
+	bool writing = mode[0] == 'w';
+	if (!writing && !exists(path)) return File();
+	return File(&files, path.c_str(), writing);
+}
+
+bool FS::remove(const String &path) {
+	return files.erase(path.c_str()) > 0;
+}
+
+}
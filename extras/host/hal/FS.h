@@ -0,0 +1,62 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the SPIFFS file system, the files are kept in RAM.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_FS_h
+#define KniwwelinoHost_FS_h
+
+#include "Arduino.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace fs {
+
+typedef std::map<std::string, std::string> FileMap;
+
+class File : public Stream {
+	public:
+		File() {}
+		File(FileMap *files, const char *path, bool writing);
+
+		size_t write(uint8_t c) override;
+		size_t write(const uint8_t *buf, size_t size) override;
+		int available() override;
+		int read() override;
+		int peek() override;
+		size_t size() const;
+		void close();
+		explicit operator bool() const { return files != nullptr; }
+
+	private:
+		FileMap *files = nullptr;
+		std::shared_ptr<std::string> path;
+		size_t pos = 0;
+		bool writing = false;
+};
+
+class FS {
+	public:
+		bool begin();
+		void end();
+		bool format();
+		bool exists(const String &path);
+		File open(const String &path, const char *mode);
+		bool remove(const String &path);
+
+	private:
+		FileMap files;
+};
+
+}
+
+using fs::FS;
+using fs::File;
+
+extern fs::FS SPIFFS;
+
+#endif
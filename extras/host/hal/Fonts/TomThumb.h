@@ -0,0 +1,134 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the TomThumb font of the Adafruit GFX library, with the
+  same metrics: every glyph is 3x5 pixels on a 4 column advance, with
+  the baseline below the 5th row. The glyph shapes are close to, but not
+  the same as the original ones, lowercase letters use the uppercase
+  shapes.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_TomThumb_h
+#define KniwwelinoHost_TomThumb_h
+
+const uint8_t TomThumbBitmaps[] PROGMEM = {
+	0x00, 0x00, 0x49, 0x04, 0xB4, 0x00, 0xBE, 0xFA, 0x79, 0x3C, 0x85, 0x42, 0xDB, 0xD6, 0x48, 0x00,
+	0x29, 0x22, 0x89, 0x28, 0xAA, 0x80, 0x0B, 0xA0, 0x00, 0x28, 0x03, 0x80, 0x00, 0x04, 0x25, 0x48,
+	0x76, 0xDC, 0x59, 0x24, 0xC5, 0x4E, 0xC5, 0x1C, 0xB7, 0x92, 0xF3, 0x1C, 0x73, 0xDE, 0xE5, 0x48,
+	0xF7, 0xDE, 0xF7, 0x9C, 0x08, 0x20, 0x08, 0x28, 0x2A, 0x22, 0x1C, 0x70, 0x88, 0xA8, 0xE5, 0x04,
+	0x57, 0xC6, 0x57, 0xDA, 0xD7, 0x5C, 0x72, 0x46, 0xD6, 0xDC, 0xF3, 0xCE, 0xF3, 0xC8, 0x73, 0xD6,
+	0xB7, 0xDA, 0xE9, 0x2E, 0x24, 0xD4, 0xB7, 0x5A, 0x92, 0x4E, 0xBF, 0xDA, 0xBF, 0xFA, 0x56, 0xD4,
+	0xD7, 0x48, 0x56, 0xF6, 0xD7, 0xEA, 0x71, 0x1C, 0xE9, 0x24, 0xB6, 0xD6, 0xB6, 0xA4, 0xB7, 0xFA,
+	0xB5, 0x5A, 0xB5, 0x24, 0xE5, 0x4E, 0xF2, 0x4E, 0x11, 0x10, 0xE4, 0x9E, 0x54, 0x00, 0x00, 0x0E,
+	0x88, 0x00, 0x57, 0xDA, 0xD7, 0x5C, 0x72, 0x46, 0xD6, 0xDC, 0xF3, 0xCE, 0xF3, 0xC8, 0x73, 0xD6,
+	0xB7, 0xDA, 0xE9, 0x2E, 0x24, 0xD4, 0xB7, 0x5A, 0x92, 0x4E, 0xBF, 0xDA, 0xBF, 0xFA, 0x56, 0xD4,
+	0xD7, 0x48, 0x56, 0xF6, 0xD7, 0xEA, 0x71, 0x1C, 0xE9, 0x24, 0xB6, 0xD6, 0xB6, 0xA4, 0xB7, 0xFA,
+	0xB5, 0x5A, 0xB5, 0x24, 0xE5, 0x4E, 0x6A, 0x26, 0x48, 0x24, 0xC8, 0xAC, 0x78, 0x00
+};
+
+const GFXglyph TomThumbGlyphs[] PROGMEM = {
+	{   0, 3, 5, 4, 0, -5 },	// 0x20 ' '
+	{   2, 3, 5, 4, 0, -5 },	// 0x21 '!'
+	{   4, 3, 5, 4, 0, -5 },	// 0x22 '"'
+	{   6, 3, 5, 4, 0, -5 },	// 0x23 '#'
+	{   8, 3, 5, 4, 0, -5 },	// 0x24 '$'
+	{  10, 3, 5, 4, 0, -5 },	// 0x25 '%'
+	{  12, 3, 5, 4, 0, -5 },	// 0x26 '&'
+	{  14, 3, 5, 4, 0, -5 },	// 0x27 '\''
+	{  16, 3, 5, 4, 0, -5 },	// 0x28 '('
+	{  18, 3, 5, 4, 0, -5 },	// 0x29 ')'
+	{  20, 3, 5, 4, 0, -5 },	// 0x2A '*'
+	{  22, 3, 5, 4, 0, -5 },	// 0x2B '+'
+	{  24, 3, 5, 4, 0, -5 },	// 0x2C ','
+	{  26, 3, 5, 4, 0, -5 },	// 0x2D '-'
+	{  28, 3, 5, 4, 0, -5 },	// 0x2E '.'
+	{  30, 3, 5, 4, 0, -5 },	// 0x2F '/'
+	{  32, 3, 5, 4, 0, -5 },	// 0x30 '0'
+	{  34, 3, 5, 4, 0, -5 },	// 0x31 '1'
+	{  36, 3, 5, 4, 0, -5 },	// 0x32 '2'
+	{  38, 3, 5, 4, 0, -5 },	// 0x33 '3'
+	{  40, 3, 5, 4, 0, -5 },	// 0x34 '4'
+	{  42, 3, 5, 4, 0, -5 },	// 0x35 '5'
+	{  44, 3, 5, 4, 0, -5 },	// 0x36 '6'
+	{  46, 3, 5, 4, 0, -5 },	// 0x37 '7'
+	{  48, 3, 5, 4, 0, -5 },	// 0x38 '8'
+	{  50, 3, 5, 4, 0, -5 },	// 0x39 '9'
+	{  52, 3, 5, 4, 0, -5 },	// 0x3A ':'
+	{  54, 3, 5, 4, 0, -5 },	// 0x3B ';'
+	{  56, 3, 5, 4, 0, -5 },	// 0x3C '<'
+	{  58, 3, 5, 4, 0, -5 },	// 0x3D '='
+	{  60, 3, 5, 4, 0, -5 },	// 0x3E '>'
+	{  62, 3, 5, 4, 0, -5 },	// 0x3F '?'
+	{  64, 3, 5, 4, 0, -5 },	// 0x40 '@'
+	{  66, 3, 5, 4, 0, -5 },	// 0x41 'A'
+	{  68, 3, 5, 4, 0, -5 },	// 0x42 'B'
+	{  70, 3, 5, 4, 0, -5 },	// 0x43 'C'
+	{  72, 3, 5, 4, 0, -5 },	// 0x44 'D'
+	{  74, 3, 5, 4, 0, -5 },	// 0x45 'E'
+	{  76, 3, 5, 4, 0, -5 },	// 0x46 'F'
+	{  78, 3, 5, 4, 0, -5 },	// 0x47 'G'
+	{  80, 3, 5, 4, 0, -5 },	// 0x48 'H'
+	{  82, 3, 5, 4, 0, -5 },	// 0x49 'I'
+	{  84, 3, 5, 4, 0, -5 },	// 0x4A 'J'
+	{  86, 3, 5, 4, 0, -5 },	// 0x4B 'K'
+	{  88, 3, 5, 4, 0, -5 },	// 0x4C 'L'
+	{  90, 3, 5, 4, 0, -5 },	// 0x4D 'M'
+	{  92, 3, 5, 4, 0, -5 },	// 0x4E 'N'
+	{  94, 3, 5, 4, 0, -5 },	// 0x4F 'O'
+	{  96, 3, 5, 4, 0, -5 },	// 0x50 'P'
+	{  98, 3, 5, 4, 0, -5 },	// 0x51 'Q'
+	{ 100, 3, 5, 4, 0, -5 },	// 0x52 'R'
+	{ 102, 3, 5, 4, 0, -5 },	// 0x53 'S'
+	{ 104, 3, 5, 4, 0, -5 },	// 0x54 'T'
+	{ 106, 3, 5, 4, 0, -5 },	// 0x55 'U'
+	{ 108, 3, 5, 4, 0, -5 },	// 0x56 'V'
+	{ 110, 3, 5, 4, 0, -5 },	// 0x57 'W'
+	{ 112, 3, 5, 4, 0, -5 },	// 0x58 'X'
+	{ 114, 3, 5, 4, 0, -5 },	// 0x59 'Y'
+	{ 116, 3, 5, 4, 0, -5 },	// 0x5A 'Z'
+	{ 118, 3, 5, 4, 0, -5 },	// 0x5B '['
+	{ 120, 3, 5, 4, 0, -5 },	// 0x5C '\\'
+	{ 122, 3, 5, 4, 0, -5 },	// 0x5D ']'
+	{ 124, 3, 5, 4, 0, -5 },	// 0x5E '^'
+	{ 126, 3, 5, 4, 0, -5 },	// 0x5F '_'
+	{ 128, 3, 5, 4, 0, -5 },	// 0x60 '`'
+	{ 130, 3, 5, 4, 0, -5 },	// 0x61 'a'
+	{ 132, 3, 5, 4, 0, -5 },	// 0x62 'b'
+	{ 134, 3, 5, 4, 0, -5 },	// 0x63 'c'
+	{ 136, 3, 5, 4, 0, -5 },	// 0x64 'd'
+	{ 138, 3, 5, 4, 0, -5 },	// 0x65 'e'
+	{ 140, 3, 5, 4, 0, -5 },	// 0x66 'f'
+	{ 142, 3, 5, 4, 0, -5 },	// 0x67 'g'
+	{ 144, 3, 5, 4, 0, -5 },	// 0x68 'h'
+	{ 146, 3, 5, 4, 0, -5 },	// 0x69 'i'
+	{ 148, 3, 5, 4, 0, -5 },	// 0x6A 'j'
+	{ 150, 3, 5, 4, 0, -5 },	// 0x6B 'k'
+	{ 152, 3, 5, 4, 0, -5 },	// 0x6C 'l'
+	{ 154, 3, 5, 4, 0, -5 },	// 0x6D 'm'
+	{ 156, 3, 5, 4, 0, -5 },	// 0x6E 'n'
+	{ 158, 3, 5, 4, 0, -5 },	// 0x6F 'o'
+	{ 160, 3, 5, 4, 0, -5 },	// 0x70 'p'
+	{ 162, 3, 5, 4, 0, -5 },	// 0x71 'q'
+	{ 164, 3, 5, 4, 0, -5 },	// 0x72 'r'
+	{ 166, 3, 5, 4, 0, -5 },	// 0x73 's'
+	{ 168, 3, 5, 4, 0, -5 },	// 0x74 't'
+	{ 170, 3, 5, 4, 0, -5 },	// 0x75 'u'
+	{ 172, 3, 5, 4, 0, -5 },	// 0x76 'v'
+	{ 174, 3, 5, 4, 0, -5 },	// 0x77 'w'
+	{ 176, 3, 5, 4, 0, -5 },	// 0x78 'x'
+	{ 178, 3, 5, 4, 0, -5 },	// 0x79 'y'
+	{ 180, 3, 5, 4, 0, -5 },	// 0x7A 'z'
+	{ 182, 3, 5, 4, 0, -5 },	// 0x7B '{'
+	{ 184, 3, 5, 4, 0, -5 },	// 0x7C '|'
+	{ 186, 3, 5, 4, 0, -5 },	// 0x7D '}'
+	{ 188, 3, 5, 4, 0, -5 } 	// 0x7E '~'
+};
+
+const GFXfont TomThumb PROGMEM = {
+	(uint8_t *) TomThumbBitmaps,
+	(GFXglyph *) TomThumbGlyphs,
+	0x20, 0x7E, 6
+};
+
+#endif
@@ -0,0 +1,26 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the arduino-mqtt library, see MQTTClient.h.
+
+ ****************************************************/
+#include "MQTTClient.h"
+
+void MQTTClient::hostReceive(const char topic[], const char payload[]) {
+	// the library hands over its own 0 terminated receive buffers
+	size_t topicLen = strlen(topic);
+	size_t length = strlen(payload);
+	char topicBuf[topicLen + 1];
+	char payloadBuf[length + 1];
+	memcpy(topicBuf, topic, topicLen + 1);
+	memcpy(payloadBuf, payload, length + 1);
+
+	if (advancedCallback != nullptr) {
+		advancedCallback(this, topicBuf, payloadBuf, (int) length);
+	} else if (simpleCallback != nullptr) {
+		String t = topicBuf;
+		String p = payloadBuf;
+		simpleCallback(t, p);
+	}
+}
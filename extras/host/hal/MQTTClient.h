@@ -0,0 +1,66 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the arduino-mqtt library v2.3. There is no broker, the
+  client is connected after connect() and publish() only counts. A test
+  hands incoming messages to the callbacks with hostReceive().
+
+ ****************************************************/
+#ifndef KniwwelinoHost_MQTTClient_h
+#define KniwwelinoHost_MQTTClient_h
+
+#include "Arduino.h"
+#include "ESP8266WiFi.h"
+
+class MQTTClient;
+
+typedef void (*MQTTClientCallbackSimple)(String &topic, String &payload);
+typedef void (*MQTTClientCallbackAdvanced)(MQTTClient *client, char topic[], char bytes[], int length);
+
+class MQTTClient {
+	public:
+		explicit MQTTClient(int bufSize = 128) : bufSize(bufSize) {}
+
+		void begin(const char hostname[], int port, Client &client) {}
+		void onMessage(MQTTClientCallbackSimple cb) { simpleCallback = cb; }
+		void onMessageAdvanced(MQTTClientCallbackAdvanced cb) { advancedCallback = cb; }
+
+		bool connect(const char clientId[], const char username[] = nullptr, const char password[] = nullptr) {
+			hostConnected = true;
+			return true;
+		}
+		void disconnect() { hostConnected = false; }
+		bool connected() { return hostConnected; }
+		bool loop() { return hostConnected; }
+
+		bool publish(const String &topic) { return publish(topic.c_str(), ""); }
+		bool publish(const char topic[]) { return publish(topic, ""); }
+		bool publish(const String &topic, const String &payload) { return publish(topic.c_str(), payload.c_str()); }
+		bool publish(const char topic[], const String &payload) { return publish(topic, payload.c_str()); }
+		bool publish(const String &topic, const char payload[]) { return publish(topic.c_str(), payload); }
+		bool publish(const char topic[], const char payload[]) { return publish(topic, payload, (int) strlen(payload)); }
+		bool publish(const char topic[], const char payload[], int length) {
+			if (!hostConnected) return false;
+			hostPublished++;
+			return true;
+		}
+
+		bool subscribe(const String &topic) { return subscribe(topic.c_str()); }
+		bool subscribe(const char topic[]) { return hostConnected; }
+		bool unsubscribe(const String &topic) { return unsubscribe(topic.c_str()); }
+		bool unsubscribe(const char topic[]) { return hostConnected; }
+
+		// host only: passes a message to the callbacks as if it came from the broker
+		void hostReceive(const char topic[], const char payload[]);
+
+		bool hostConnected = false;
+		uint32_t hostPublished = 0;
+
+	private:
+		int bufSize;
+		MQTTClientCallbackSimple simpleCallback = nullptr;
+		MQTTClientCallbackAdvanced advancedCallback = nullptr;
+};
+
+#endif
@@ -0,0 +1,167 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the Print and Stream classes of the Arduino core.
+
+ ****************************************************/
+#include "Arduino.h"
+
+#include <stdarg.h>
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+	size_t n = 0;
+	while (size--) n += write(*buffer++);
+	return n;
+}
+
+size_t Print::printf(const char *format, ...) {
+	va_list arg;
+	va_start(arg, format);
+	char temp[64];
+	char* buffer = temp;
+	size_t len = vsnprintf(temp, sizeof(temp), format, arg);
+	va_end(arg);
+	if (len > sizeof(temp) - 1) {
+		buffer = new char[len + 1];
+		va_start(arg, format);
+		vsnprintf(buffer, len + 1, format, arg);
+		va_end(arg);
+	}
+	len = write((const uint8_t*) buffer, len);
+	if (buffer != temp) delete[] buffer;
+	return len;
+}
+
+size_t Print::print(const __FlashStringHelper *s) {
+	return print((const char*) s);
+}
+
+size_t Print::print(const String &s) {
+	return write(s.c_str(), s.length());
+}
+
+size_t Print::print(const char s[]) {
+	return write(s);
+}
+
+size_t Print::print(char c) {
+	return write(c);
+}
+
+size_t Print::print(unsigned char b, int base) {
+	return print((unsigned long) b, base);
+}
+
+size_t Print::print(int n, int base) {
+	return print((long) n, base);
+}
+
+size_t Print::print(unsigned int n, int base) {
+	return print((unsigned long) n, base);
+}
+
+size_t Print::print(long n, int base) {
+	if (base == 10 && n < 0) {
+		return print('-') + printNumber(-n, 10);
+	}
+	return printNumber(n, base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+	if (base == 0) return write(n);
+	return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) {
+	return printFloat(n, digits);
+}
+
+size_t Print::println(const __FlashStringHelper *s) {
+	return print(s) + println();
+}
+
+size_t Print::println(const String &s) {
+	return print(s) + println();
+}
+
+size_t Print::println(const char s[]) {
+	return print(s) + println();
+}
+
+size_t Print::println(char c) {
+	return print(c) + println();
+}
+
+size_t Print::println(unsigned char b, int base) {
+	return print(b, base) + println();
+}
+
+size_t Print::println(int n, int base) {
+	return print(n, base) + println();
+}
+
+size_t Print::println(unsigned int n, int base) {
+	return print(n, base) + println();
+}
+
+size_t Print::println(long n, int base) {
+	return print(n, base) + println();
+}
+
+size_t Print::println(unsigned long n, int base) {
+	return print(n, base) + println();
+}
+
+size_t Print::println(double n, int digits) {
+	return print(n, digits) + println();
+}
+
+size_t Print::println() {
+	return write("\r\n");
+}
+
+size_t Print::printNumber(unsigned long n, uint8_t base) {
+	char buf[8 * sizeof(long) + 1];
+	char *str = &buf[sizeof(buf) - 1];
+	*str = '\0';
+	if (base < 2) base = 10;
+	do {
+		unsigned long m = n;
+		n /= base;
+		char c = m - base * n;
+		*--str = c < 10 ? c + '0' : c + 'A' - 10;
+	} while (n);
+	return write(str);
+}
+
+size_t Print::printFloat(double number, uint8_t digits) {
+	char buf[33];
+	snprintf(buf, sizeof(buf), "%.*f", digits, number);
+	return write(buf);
+}
+
+size_t Stream::readBytes(char *buffer, size_t length) {
+	size_t count = 0;
+	while (count < length) {
+		int c = read();
+		if (c < 0) break;
+		*buffer++ = (char) c;
+		count++;
+	}
+	return count;
+}
+
+String Stream::readString() {
+	String ret;
+	int c;
+	while ((c = read()) >= 0) ret += (char) c;
+	return ret;
+}
+
+String Stream::readStringUntil(char terminator) {
+	String ret;
+	int c;
+	while ((c = read()) >= 0 && c != terminator) ret += (char) c;
+	return ret;
+}
@@ -0,0 +1,69 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the Print and Stream classes of the Arduino core.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_Print_h
+#define KniwwelinoHost_Print_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print {
+	public:
+		virtual ~Print() {}
+		virtual size_t write(uint8_t c) = 0;
+		virtual size_t write(const uint8_t *buffer, size_t size);
+		size_t write(const char *str) { return str == nullptr ? 0 : write((const uint8_t*) str, strlen(str)); }
+		size_t write(const char *buffer, size_t size) { return write((const uint8_t*) buffer, size); }
+
+		size_t printf(const char *format, ...) __attribute__ ((format (printf, 2, 3)));
+		size_t print(const __FlashStringHelper *s);
+		size_t print(const String &s);
+		size_t print(const char s[]);
+		size_t print(char c);
+		size_t print(unsigned char n, int base = DEC);
+		size_t print(int n, int base = DEC);
+		size_t print(unsigned int n, int base = DEC);
+		size_t print(long n, int base = DEC);
+		size_t print(unsigned long n, int base = DEC);
+		size_t print(double n, int digits = 2);
+
+		size_t println(const __FlashStringHelper *s);
+		size_t println(const String &s);
+		size_t println(const char s[]);
+		size_t println(char c);
+		size_t println(unsigned char n, int base = DEC);
+		size_t println(int n, int base = DEC);
+		size_t println(unsigned int n, int base = DEC);
+		size_t println(long n, int base = DEC);
+		size_t println(unsigned long n, int base = DEC);
+		size_t println(double n, int digits = 2);
+		size_t println();
+
+	private:
+		size_t printNumber(unsigned long n, uint8_t base);
+		size_t printFloat(double n, uint8_t digits);
+};
+
+class Stream : public Print {
+	public:
+		virtual int available() = 0;
+		virtual int read() = 0;
+		virtual int peek() = 0;
+		size_t readBytes(char *buffer, size_t length);
+		String readString();
+		String readStringUntil(char terminator);
+};
+
+#endif
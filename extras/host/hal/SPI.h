@@ -0,0 +1,11 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the SPI library, not used by the library itself.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_SPI_h
+#define KniwwelinoHost_SPI_h
+
+#endif
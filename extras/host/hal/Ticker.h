@@ -0,0 +1,69 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the Ticker library of the ESP8266 core. The host never
+  fires the timers on its own, the callback is kept so that a test or
+  benchmark can call fire() at the times it chooses.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_Ticker_h
+#define KniwwelinoHost_Ticker_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+class Ticker {
+	public:
+		typedef void (*callback_t)(void);
+		typedef void (*callback_with_arg_t)(void*);
+
+		void attach(float seconds, callback_t callback) {
+			_attach_ms(seconds * 1000, true, reinterpret_cast<callback_with_arg_t>(callback), nullptr);
+		}
+		void attach_ms(uint32_t milliseconds, callback_t callback) {
+			_attach_ms(milliseconds, true, reinterpret_cast<callback_with_arg_t>(callback), nullptr);
+		}
+		template<typename TArg> void attach_ms(uint32_t milliseconds, void (*callback)(TArg), TArg arg) {
+			_attach_ms(milliseconds, true, reinterpret_cast<callback_with_arg_t>(callback), (void*)(uintptr_t) arg);
+		}
+		void once_ms(uint32_t milliseconds, callback_t callback) {
+			_attach_ms(milliseconds, false, reinterpret_cast<callback_with_arg_t>(callback), nullptr);
+		}
+		template<typename TArg> void once_ms(uint32_t milliseconds, void (*callback)(TArg), TArg arg) {
+			_attach_ms(milliseconds, false, reinterpret_cast<callback_with_arg_t>(callback), (void*)(uintptr_t) arg);
+		}
+		void detach() {
+			_callback = nullptr;
+			_ms = 0;
+		}
+		bool active() const {
+			return _callback != nullptr;
+		}
+
+		// host only: runs the callback once, as the timer would
+		void fire() {
+			callback_with_arg_t cb = _callback;
+			if (cb == nullptr) return;
+			if (!_repeat) _callback = nullptr;
+			cb(_arg);
+		}
+		uint32_t periodMs() const {
+			return _ms;
+		}
+
+	private:
+		void _attach_ms(uint32_t ms, bool repeat, callback_with_arg_t callback, void* arg) {
+			_ms = ms;
+			_repeat = repeat;
+			_callback = callback;
+			_arg = arg;
+		}
+
+		callback_with_arg_t _callback = nullptr;
+		void* _arg = nullptr;
+		uint32_t _ms = 0;
+		bool _repeat = false;
+};
+
+#endif
@@ -0,0 +1,74 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the Time library, see TimeLib.h.
+
+ ****************************************************/
+#include "Arduino.h"
+#include "TimeLib.h"
+
+static time_t sysTime = 0;
+static unsigned long sysMillis = 0;
+static getExternalTime syncProvider = nullptr;
+static time_t syncInterval = 300;
+static unsigned long nextSync = 0;
+
+time_t now() {
+	unsigned long ms = millis();
+	if (syncProvider != nullptr && (long)(ms - nextSync) >= 0) {
+		time_t t = syncProvider();
+		if (t != 0) setTime(t);
+		nextSync = ms + syncInterval * 1000;
+	}
+	return sysTime + (ms - sysMillis) / 1000;
+}
+
+static struct tm nowTm() {
+	time_t t = now();
+	struct tm tm;
+	gmtime_r(&t, &tm);
+	return tm;
+}
+
+int hour() {
+	return nowTm().tm_hour;
+}
+
+int minute() {
+	return nowTm().tm_min;
+}
+
+int second() {
+	return nowTm().tm_sec;
+}
+
+int day() {
+	return nowTm().tm_mday;
+}
+
+int weekday() {
+	return nowTm().tm_wday + 1;
+}
+
+int month() {
+	return nowTm().tm_mon + 1;
+}
+
+int year() {
+	return nowTm().tm_year + 1900;
+}
+
+void setTime(time_t t) {
+	sysTime = t;
+	sysMillis = millis();
+}
+
+void setSyncProvider(getExternalTime getTimeFunction) {
+	syncProvider = getTimeFunction;
+	nextSync = millis();
+}
+
+void setSyncInterval(time_t interval) {
+	syncInterval = interval;
+}
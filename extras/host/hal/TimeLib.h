@@ -0,0 +1,28 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the Time library, the clock is set by the sync provider
+  and runs with millis().
+
+ ****************************************************/
+#ifndef KniwwelinoHost_TimeLib_h
+#define KniwwelinoHost_TimeLib_h
+
+#include <time.h>
+
+typedef time_t (*getExternalTime)();
+
+time_t now();
+int hour();
+int minute();
+int second();
+int day();
+int weekday();
+int month();
+int year();
+void setTime(time_t t);
+void setSyncProvider(getExternalTime getTimeFunction);
+void setSyncInterval(time_t interval);
+
+#endif
@@ -0,0 +1,38 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the Timezone library, DST rules are not evaluated, the
+  standard time offset is always used.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_Timezone_h
+#define KniwwelinoHost_Timezone_h
+
+#include <stdint.h>
+#include <time.h>
+
+enum week_t { Last, First, Second, Third, Fourth };
+enum dow_t { Sun = 1, Mon, Tue, Wed, Thu, Fri, Sat };
+enum month_t { Jan = 1, Feb, Mar, Apr, May, Jun, Jul, Aug, Sep, Oct, Nov, Dec };
+
+struct TimeChangeRule {
+	char abbrev[6];
+	uint8_t week;
+	uint8_t dow;
+	uint8_t month;
+	uint8_t hour;
+	int offset;		// minutes from UTC
+};
+
+class Timezone {
+	public:
+		Timezone(TimeChangeRule dstStart, TimeChangeRule stdStart) : _dst(dstStart), _std(stdStart) {}
+		time_t toLocal(time_t utc) { return utc + _std.offset * 60; }
+
+	private:
+		TimeChangeRule _dst;
+		TimeChangeRule _std;
+};
+
+#endif
@@ -0,0 +1,492 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the String class of the ESP8266 Arduino core 2.4.
+
+ ****************************************************/
+#include "Arduino.h"
+
+#include <ctype.h>
+
+String::String(const char *cstr) {
+	init();
+	if (cstr) copy(cstr, strlen(cstr));
+}
+
+String::String(const String &value) {
+	init();
+	*this = value;
+}
+
+String::String(String &&rval) {
+	init();
+	move(rval);
+}
+
+String::String(StringSumHelper &&rval) {
+	init();
+	move(rval);
+}
+
+String::String(const __FlashStringHelper *pstr) {
+	init();
+	*this = pstr;
+}
+
+String::String(char c) {
+	init();
+	char buf[2] = { c, 0 };
+	*this = buf;
+}
+
+String::String(unsigned char value, unsigned char base) : String((unsigned long) value, base) {
+}
+
+String::String(int value, unsigned char base) : String((long) value, base) {
+}
+
+String::String(unsigned int value, unsigned char base) : String((unsigned long) value, base) {
+}
+
+String::String(long value, unsigned char base) {
+	init();
+	char buf[2 + 8 * sizeof(long)];
+	if (base == 10) {
+		snprintf(buf, sizeof(buf), "%ld", value);
+		*this = buf;
+	} else {
+		*this = String((unsigned long) value, base);
+	}
+}
+
+String::String(unsigned long value, unsigned char base) {
+	init();
+	char buf[1 + 8 * sizeof(unsigned long)];
+	char *p = buf + sizeof(buf) - 1;
+	*p = 0;
+	if (base < 2) base = 10;
+	do {
+		uint8_t digit = value % base;
+		*--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+		value /= base;
+	} while (value > 0);
+	*this = p;
+}
+
+String::String(float value, unsigned char decimalPlaces) : String((double) value, decimalPlaces) {
+}
+
+String::String(double value, unsigned char decimalPlaces) {
+	init();
+	char buf[33];
+	snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
+	*this = buf;
+}
+
+String::~String() {
+	free(buffer);
+}
+
+inline void String::init() {
+	buffer = nullptr;
+	capacity = 0;
+	len = 0;
+}
+
+void String::invalidate() {
+	free(buffer);
+	init();
+}
+
+unsigned char String::reserve(unsigned int size) {
+	if (buffer && capacity >= size) return 1;
+	if (changeBuffer(size)) {
+		if (len == 0) buffer[0] = 0;
+		return 1;
+	}
+	return 0;
+}
+
+unsigned char String::changeBuffer(unsigned int maxStrLen) {
+	char *newbuffer = (char *) realloc(buffer, maxStrLen + 1);
+	if (newbuffer) {
+		buffer = newbuffer;
+		capacity = maxStrLen;
+		return 1;
+	}
+	return 0;
+}
+
+String & String::copy(const char *cstr, unsigned int length) {
+	if (!reserve(length)) {
+		invalidate();
+		return *this;
+	}
+	len = length;
+	memmove(buffer, cstr, length);
+	buffer[len] = 0;
+	return *this;
+}
+
+void String::move(String &rhs) {
+	if (buffer) {
+		if (capacity >= rhs.len && rhs.buffer) {
+			memcpy(buffer, rhs.buffer, rhs.len + 1);
+			len = rhs.len;
+			rhs.len = 0;
+			return;
+		}
+		free(buffer);
+	}
+	buffer = rhs.buffer;
+	capacity = rhs.capacity;
+	len = rhs.len;
+	rhs.init();
+}
+
+String & String::operator =(const String &rhs) {
+	if (this == &rhs) return *this;
+	if (rhs.buffer) copy(rhs.buffer, rhs.len);
+	else invalidate();
+	return *this;
+}
+
+String & String::operator =(String &&rval) {
+	if (this != &rval) move(rval);
+	return *this;
+}
+
+String & String::operator =(StringSumHelper &&rval) {
+	if (this != &rval) move(rval);
+	return *this;
+}
+
+String & String::operator =(const char *cstr) {
+	if (cstr) copy(cstr, strlen(cstr));
+	else invalidate();
+	return *this;
+}
+
+String & String::operator =(const __FlashStringHelper *pstr) {
+	return *this = (const char*) pstr;
+}
+
+unsigned char String::concat(const String &s) {
+	return concat(s.buffer, s.len);
+}
+
+unsigned char String::concat(const char *cstr, unsigned int length) {
+	unsigned int newlen = len + length;
+	if (!cstr) return 0;
+	if (length == 0) return 1;
+	if (!reserve(newlen)) return 0;
+	memmove(buffer + len, cstr, length);
+	len = newlen;
+	buffer[len] = 0;
+	return 1;
+}
+
+unsigned char String::concat(const char *cstr) {
+	if (!cstr) return 0;
+	return concat(cstr, strlen(cstr));
+}
+
+unsigned char String::concat(char c) {
+	char buf[2] = { c, 0 };
+	return concat(buf, 1);
+}
+
+unsigned char String::concat(unsigned char num) {
+	return concat((unsigned long) num);
+}
+
+unsigned char String::concat(int num) {
+	return concat((long) num);
+}
+
+unsigned char String::concat(unsigned int num) {
+	return concat((unsigned long) num);
+}
+
+unsigned char String::concat(long num) {
+	char buf[2 + 3 * sizeof(long)];
+	snprintf(buf, sizeof(buf), "%ld", num);
+	return concat(buf, strlen(buf));
+}
+
+unsigned char String::concat(unsigned long num) {
+	char buf[1 + 3 * sizeof(unsigned long)];
+	snprintf(buf, sizeof(buf), "%lu", num);
+	return concat(buf, strlen(buf));
+}
+
+unsigned char String::concat(float num) {
+	return concat((double) num);
+}
+
+unsigned char String::concat(double num) {
+	char buf[33];
+	snprintf(buf, sizeof(buf), "%.2f", num);
+	return concat(buf, strlen(buf));
+}
+
+unsigned char String::concat(const __FlashStringHelper *str) {
+	return concat((const char*) str);
+}
+
+StringSumHelper & operator +(const StringSumHelper &lhs, const String &rhs) {
+	StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
+	if (!a.concat(rhs.buffer, rhs.len)) a.invalidate();
+	return a;
+}
+
+StringSumHelper & operator +(const StringSumHelper &lhs, const char *cstr) {
+	StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
+	if (!cstr || !a.concat(cstr, strlen(cstr))) a.invalidate();
+	return a;
+}
+
+StringSumHelper & operator +(const StringSumHelper &lhs, char c) {
+	StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
+	if (!a.concat(c)) a.invalidate();
+	return a;
+}
+
+StringSumHelper & operator +(const StringSumHelper &lhs, unsigned char num) {
+	StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
+	if (!a.concat(num)) a.invalidate();
+	return a;
+}
+
+StringSumHelper & operator +(const StringSumHelper &lhs, int num) {
+	StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
+	if (!a.concat(num)) a.invalidate();
+	return a;
+}
+
+StringSumHelper & operator +(const StringSumHelper &lhs, unsigned int num) {
+	StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
+	if (!a.concat(num)) a.invalidate();
+	return a;
+}
+
+StringSumHelper & operator +(const StringSumHelper &lhs, long num) {
+	StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
+	if (!a.concat(num)) a.invalidate();
+	return a;
+}
+
+StringSumHelper & operator +(const StringSumHelper &lhs, unsigned long num) {
+	StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
+	if (!a.concat(num)) a.invalidate();
+	return a;
+}
+
+StringSumHelper & operator +(const StringSumHelper &lhs, float num) {
+	StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
+	if (!a.concat(num)) a.invalidate();
+	return a;
+}
+
+StringSumHelper & operator +(const StringSumHelper &lhs, double num) {
+	StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
+	if (!a.concat(num)) a.invalidate();
+	return a;
+}
+
+StringSumHelper & operator +(const StringSumHelper &lhs, const __FlashStringHelper *rhs) {
+	return lhs + (const char*) rhs;
+}
+
+int String::compareTo(const String &s) const {
+	return strcmp(c_str(), s.c_str());
+}
+
+unsigned char String::equals(const String &s2) const {
+	return (len == s2.len && compareTo(s2) == 0);
+}
+
+unsigned char String::equals(const char *cstr) const {
+	return strcmp(c_str(), cstr ? cstr : "") == 0;
+}
+
+unsigned char String::equalsIgnoreCase(const String &s2) const {
+	return len == s2.len && strcasecmp(c_str(), s2.c_str()) == 0;
+}
+
+unsigned char String::startsWith(const String &s2) const {
+	if (len < s2.len) return 0;
+	return startsWith(s2, 0);
+}
+
+unsigned char String::startsWith(const String &s2, unsigned int offset) const {
+	if (offset > len - s2.len || !buffer || !s2.buffer) return 0;
+	return strncmp(&buffer[offset], s2.buffer, s2.len) == 0;
+}
+
+unsigned char String::endsWith(const String &s2) const {
+	if (len < s2.len || !buffer || !s2.buffer) return 0;
+	return strcmp(&buffer[len - s2.len], s2.buffer) == 0;
+}
+
+char String::charAt(unsigned int loc) const {
+	return operator[](loc);
+}
+
+void String::setCharAt(unsigned int loc, char c) {
+	if (loc < len) buffer[loc] = c;
+}
+
+char & String::operator[](unsigned int index) {
+	static char dummy_writable_char;
+	if (index >= len || !buffer) {
+		dummy_writable_char = 0;
+		return dummy_writable_char;
+	}
+	return buffer[index];
+}
+
+char String::operator[](unsigned int index) const {
+	if (index >= len || !buffer) return 0;
+	return buffer[index];
+}
+
+void String::getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index) const {
+	if (!bufsize || !buf) return;
+	if (index >= len) {
+		buf[0] = 0;
+		return;
+	}
+	unsigned int n = bufsize - 1;
+	if (n > len - index) n = len - index;
+	strncpy((char *) buf, buffer + index, n);
+	buf[n] = 0;
+}
+
+int String::indexOf(char c) const {
+	return indexOf(c, 0);
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+	if (fromIndex >= len) return -1;
+	const char* temp = strchr(buffer + fromIndex, ch);
+	if (temp == nullptr) return -1;
+	return temp - buffer;
+}
+
+int String::indexOf(const String &s2) const {
+	return indexOf(s2, 0);
+}
+
+int String::indexOf(const String &s2, unsigned int fromIndex) const {
+	if (fromIndex >= len) return -1;
+	const char *found = strstr(buffer + fromIndex, s2.c_str());
+	if (found == nullptr) return -1;
+	return found - buffer;
+}
+
+int String::lastIndexOf(char theChar) const {
+	return lastIndexOf(theChar, len - 1);
+}
+
+int String::lastIndexOf(char ch, unsigned int fromIndex) const {
+	if (fromIndex >= len) return -1;
+	for (int i = fromIndex; i >= 0; i--) {
+		if (buffer[i] == ch) return i;
+	}
+	return -1;
+}
+
+int String::lastIndexOf(const String &s2) const {
+	return lastIndexOf(s2, len - s2.len);
+}
+
+int String::lastIndexOf(const String &s2, unsigned int fromIndex) const {
+	if (s2.len == 0 || len == 0 || s2.len > len) return -1;
+	if (fromIndex >= len) fromIndex = len - 1;
+	int found = -1;
+	for (char *p = buffer; p <= buffer + fromIndex; p++) {
+		p = strstr(p, s2.buffer);
+		if (!p) break;
+		if ((unsigned int)(p - buffer) <= fromIndex) found = p - buffer;
+	}
+	return found;
+}
+
+String String::substring(unsigned int left, unsigned int right) const {
+	if (left > right) {
+		unsigned int temp = right;
+		right = left;
+		left = temp;
+	}
+	String out;
+	if (left >= len) return out;
+	if (right > len) right = len;
+	out.copy(buffer + left, right - left);
+	return out;
+}
+
+void String::replace(char find, char replace) {
+	if (!buffer) return;
+	for (char *p = buffer; *p; p++) {
+		if (*p == find) *p = replace;
+	}
+}
+
+void String::replace(const String &find, const String &replace) {
+	if (len == 0 || find.len == 0) return;
+	String out;
+	unsigned int pos = 0;
+	int found;
+	while ((found = indexOf(find, pos)) >= 0) {
+		out.concat(buffer + pos, found - pos);
+		out.concat(replace);
+		pos = found + find.len;
+	}
+	if (pos == 0) return;
+	out.concat(buffer + pos, len - pos);
+	move(out);
+}
+
+void String::remove(unsigned int index) {
+	remove(index, (unsigned int) -1);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+	if (index >= len) return;
+	if (count > len - index) count = len - index;
+	memmove(buffer + index, buffer + index + count, len - index - count + 1);
+	len -= count;
+}
+
+void String::toLowerCase() {
+	if (!buffer) return;
+	for (char *p = buffer; *p; p++) *p = tolower(*p);
+}
+
+void String::toUpperCase() {
+	if (!buffer) return;
+	for (char *p = buffer; *p; p++) *p = toupper(*p);
+}
+
+void String::trim() {
+	if (!buffer || len == 0) return;
+	char *begin = buffer;
+	while (isspace(*begin)) begin++;
+	char *end = buffer + len - 1;
+	while (isspace(*end) && end >= begin) end--;
+	len = end + 1 - begin;
+	if (begin > buffer) memmove(buffer, begin, len);
+	buffer[len] = 0;
+}
+
+long String::toInt() const {
+	if (buffer) return atol(buffer);
+	return 0;
+}
+
+float String::toFloat() const {
+	if (buffer) return atof(buffer);
+	return 0;
+}
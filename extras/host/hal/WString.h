@@ -0,0 +1,155 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the String class of the ESP8266 Arduino core 2.4.
+  Like the original it keeps the text in one heap buffer that grows with
+  realloc() (no small string buffer), so the host benchmark counts the
+  same allocations as the board.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_WString_h
+#define KniwwelinoHost_WString_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class __FlashStringHelper;
+class StringSumHelper;
+
+class String {
+	public:
+		String(const char *cstr = "");
+		String(const String &str);
+		String(String &&rval);
+		String(StringSumHelper &&rval);
+		String(const __FlashStringHelper *str);
+		explicit String(char c);
+		explicit String(unsigned char value, unsigned char base = 10);
+		explicit String(int value, unsigned char base = 10);
+		explicit String(unsigned int value, unsigned char base = 10);
+		explicit String(long value, unsigned char base = 10);
+		explicit String(unsigned long value, unsigned char base = 10);
+		explicit String(float value, unsigned char decimalPlaces = 2);
+		explicit String(double value, unsigned char decimalPlaces = 2);
+		~String();
+
+		unsigned char reserve(unsigned int size);
+		inline unsigned int length() const { return len; }
+
+		String & operator =(const String &rhs);
+		String & operator =(const char *cstr);
+		String & operator =(const __FlashStringHelper *str);
+		String & operator =(String &&rval);
+		String & operator =(StringSumHelper &&rval);
+
+		unsigned char concat(const String &str);
+		unsigned char concat(const char *cstr);
+		unsigned char concat(const char *cstr, unsigned int length);
+		unsigned char concat(char c);
+		unsigned char concat(unsigned char num);
+		unsigned char concat(int num);
+		unsigned char concat(unsigned int num);
+		unsigned char concat(long num);
+		unsigned char concat(unsigned long num);
+		unsigned char concat(float num);
+		unsigned char concat(double num);
+		unsigned char concat(const __FlashStringHelper *str);
+
+		template<typename T> String & operator +=(const T &rhs) {
+			concat(rhs);
+			return (*this);
+		}
+		String & operator +=(const char *cstr) {
+			concat(cstr);
+			return (*this);
+		}
+
+		friend StringSumHelper & operator +(const StringSumHelper &lhs, const String &rhs);
+		friend StringSumHelper & operator +(const StringSumHelper &lhs, const char *cstr);
+		friend StringSumHelper & operator +(const StringSumHelper &lhs, char c);
+		friend StringSumHelper & operator +(const StringSumHelper &lhs, unsigned char num);
+		friend StringSumHelper & operator +(const StringSumHelper &lhs, int num);
+		friend StringSumHelper & operator +(const StringSumHelper &lhs, unsigned int num);
+		friend StringSumHelper & operator +(const StringSumHelper &lhs, long num);
+		friend StringSumHelper & operator +(const StringSumHelper &lhs, unsigned long num);
+		friend StringSumHelper & operator +(const StringSumHelper &lhs, float num);
+		friend StringSumHelper & operator +(const StringSumHelper &lhs, double num);
+		friend StringSumHelper & operator +(const StringSumHelper &lhs, const __FlashStringHelper *rhs);
+
+		explicit operator bool() const { return buffer != nullptr; }
+
+		int compareTo(const String &s) const;
+		unsigned char equals(const String &s) const;
+		unsigned char equals(const char *cstr) const;
+		unsigned char operator ==(const String &rhs) const { return equals(rhs); }
+		unsigned char operator ==(const char *cstr) const { return equals(cstr); }
+		unsigned char operator !=(const String &rhs) const { return !equals(rhs); }
+		unsigned char operator !=(const char *cstr) const { return !equals(cstr); }
+		unsigned char operator <(const String &rhs) const { return compareTo(rhs) < 0; }
+		unsigned char operator >(const String &rhs) const { return compareTo(rhs) > 0; }
+		unsigned char equalsIgnoreCase(const String &s) const;
+		unsigned char startsWith(const String &prefix) const;
+		unsigned char startsWith(const String &prefix, unsigned int offset) const;
+		unsigned char endsWith(const String &suffix) const;
+
+		char charAt(unsigned int index) const;
+		void setCharAt(unsigned int index, char c);
+		char operator [](unsigned int index) const;
+		char& operator [](unsigned int index);
+		void getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index = 0) const;
+		void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const {
+			getBytes((unsigned char *) buf, bufsize, index);
+		}
+		const char * c_str() const { return buffer ? buffer : ""; }
+
+		int indexOf(char ch) const;
+		int indexOf(char ch, unsigned int fromIndex) const;
+		int indexOf(const String &str) const;
+		int indexOf(const String &str, unsigned int fromIndex) const;
+		int lastIndexOf(char ch) const;
+		int lastIndexOf(char ch, unsigned int fromIndex) const;
+		int lastIndexOf(const String &str) const;
+		int lastIndexOf(const String &str, unsigned int fromIndex) const;
+		String substring(unsigned int beginIndex) const { return substring(beginIndex, len); }
+		String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+		void replace(char find, char replace);
+		void replace(const String &find, const String &replace);
+		void remove(unsigned int index);
+		void remove(unsigned int index, unsigned int count);
+		void toLowerCase();
+		void toUpperCase();
+		void trim();
+
+		long toInt() const;
+		float toFloat() const;
+
+	protected:
+		char *buffer;
+		unsigned int capacity;
+		unsigned int len;
+
+		void init();
+		void invalidate();
+		unsigned char changeBuffer(unsigned int maxStrLen);
+		String & copy(const char *cstr, unsigned int length);
+		void move(String &rhs);
+};
+
+class StringSumHelper : public String {
+	public:
+		StringSumHelper(const String &s) : String(s) {}
+		StringSumHelper(const char *p) : String(p) {}
+		StringSumHelper(char c) : String(c) {}
+		StringSumHelper(unsigned char num) : String(num) {}
+		StringSumHelper(int num) : String(num) {}
+		StringSumHelper(unsigned int num) : String(num) {}
+		StringSumHelper(long num) : String(num) {}
+		StringSumHelper(unsigned long num) : String(num) {}
+		StringSumHelper(float num) : String(num) {}
+		StringSumHelper(double num) : String(num) {}
+};
+
+#endif
@@ -0,0 +1,20 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the WiFiManager library, the portal never connects.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_WiFiManager_h
+#define KniwwelinoHost_WiFiManager_h
+
+#include "ESP8266WiFi.h"
+
+class WiFiManager {
+	public:
+		boolean autoConnect(char const *apName, char const *apPassword = nullptr) { return false; }
+		void resetSettings() {}
+		void setTimeout(unsigned long seconds) {}
+};
+
+#endif
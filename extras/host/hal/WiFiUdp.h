@@ -0,0 +1,23 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the WiFiUdp library, no packet is ever received.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_WiFiUdp_h
+#define KniwwelinoHost_WiFiUdp_h
+
+#include "ESP8266WiFi.h"
+
+class WiFiUDP {
+	public:
+		uint8_t begin(uint16_t port) { return 1; }
+		int beginPacket(IPAddress ip, uint16_t port) { return 1; }
+		int endPacket() { return 1; }
+		size_t write(const uint8_t *buffer, size_t size) { return size; }
+		int parsePacket() { return 0; }
+		int read(unsigned char* buffer, size_t len) { return 0; }
+};
+
+#endif
@@ -0,0 +1,73 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the Wire (I2C) library, see Wire.h.
+
+ ****************************************************/
+#include "Wire.h"
+
+TwoWire Wire;
+
+void TwoWire::begin() {
+}
+
+void TwoWire::begin(int sda, int scl) {
+}
+
+void TwoWire::setClock(uint32_t frequency) {
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+	hostLastAddress = address;
+	txLen = 0;
+}
+
+uint8_t TwoWire::endTransmission(uint8_t sendStop) {
+	memcpy(hostLastTx, txBuffer, txLen);
+	hostLastTxLen = txLen;
+	hostBytesWritten += txLen;
+	hostTransmissions++;
+	txLen = 0;
+	return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop) {
+	if (quantity > WIRE_BUFFER_SIZE) quantity = WIRE_BUFFER_SIZE;
+	for (uint8_t i = 0; i < quantity; i++) {
+		rxBuffer[i] = (i < hostRxLen) ? hostRx[i] : 0;
+	}
+	rxLen = quantity;
+	rxPos = 0;
+	return quantity;
+}
+
+size_t TwoWire::write(uint8_t data) {
+	if (txLen >= WIRE_BUFFER_SIZE) return 0;
+	txBuffer[txLen++] = data;
+	return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity) {
+	size_t n = 0;
+	while (n < quantity && write(data[n])) n++;
+	return n;
+}
+
+int TwoWire::available() {
+	return rxLen - rxPos;
+}
+
+int TwoWire::read() {
+	return (rxPos < rxLen) ? rxBuffer[rxPos++] : -1;
+}
+
+int TwoWire::peek() {
+	return (rxPos < rxLen) ? rxBuffer[rxPos] : -1;
+}
+
+void TwoWire::hostSetRx(const uint8_t *data, uint8_t len) {
+	if (len > WIRE_BUFFER_SIZE) len = WIRE_BUFFER_SIZE;
+	memcpy(hostRx, data, len);
+	hostRxLen = len;
+}
@@ -0,0 +1,54 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the Wire (I2C) library. Writes are counted and the last
+  transmission is kept, reads return the bytes queued with hostSetRx().
+
+ ****************************************************/
+#ifndef KniwwelinoHost_Wire_h
+#define KniwwelinoHost_Wire_h
+
+#include "Arduino.h"
+
+#define WIRE_BUFFER_SIZE 32
+
+class TwoWire : public Stream {
+	public:
+		void begin();
+		void begin(int sda, int scl);
+		void setClock(uint32_t frequency);
+		void beginTransmission(uint8_t address);
+		void beginTransmission(int address) { beginTransmission((uint8_t) address); }
+		uint8_t endTransmission(uint8_t sendStop = true);
+		uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop = true);
+		uint8_t requestFrom(int address, int quantity) { return requestFrom((uint8_t) address, (uint8_t) quantity); }
+		uint8_t requestFrom(int address, int quantity, int sendStop) { return requestFrom((uint8_t) address, (uint8_t) quantity, (uint8_t) sendStop); }
+		size_t write(uint8_t data) override;
+		size_t write(const uint8_t *data, size_t quantity) override;
+		int available() override;
+		int read() override;
+		int peek() override;
+
+		// host only: bytes returned by the next requestFrom()
+		void hostSetRx(const uint8_t *data, uint8_t len);
+
+		uint32_t hostTransmissions = 0;		// finished writes
+		uint32_t hostBytesWritten = 0;
+		uint8_t hostLastAddress = 0;
+		uint8_t hostLastTx[WIRE_BUFFER_SIZE];
+		uint8_t hostLastTxLen = 0;
+
+	private:
+		uint8_t txBuffer[WIRE_BUFFER_SIZE];
+		uint8_t txLen = 0;
+		uint8_t rxBuffer[WIRE_BUFFER_SIZE];
+		uint8_t rxLen = 0;
+		uint8_t rxPos = 0;
+		uint8_t hostRx[WIRE_BUFFER_SIZE];
+		uint8_t hostRxLen = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
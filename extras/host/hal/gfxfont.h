@@ -0,0 +1,27 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Font structures of the Adafruit GFX library.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_gfxfont_h
+#define KniwwelinoHost_gfxfont_h
+
+#include <stdint.h>
+
+typedef struct {
+	uint16_t bitmapOffset;		// pointer into GFXfont->bitmap
+	uint8_t  width, height;		// bitmap dimensions in pixels
+	uint8_t  xAdvance;			// distance to advance cursor (x axis)
+	int8_t   xOffset, yOffset;	// dist from cursor pos to UL corner
+} GFXglyph;
+
+typedef struct {
+	uint8_t  *bitmap;			// glyph bitmaps, concatenated
+	GFXglyph *glyph;			// glyph array
+	uint8_t   first, last;		// ASCII extents
+	uint8_t   yAdvance;			// newline distance (y axis)
+} GFXfont;
+
+#endif
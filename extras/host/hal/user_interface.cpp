@@ -0,0 +1,29 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the os_timer functions of the ESP8266 SDK, see user_interface.h.
+
+ ****************************************************/
+#include "user_interface.h"
+
+#include <stddef.h>
+
+void os_timer_setfn(os_timer_t *ptimer, os_timer_func_t *pfunction, void *parg) {
+	ptimer->timer_func = pfunction;
+	ptimer->timer_arg = parg;
+	ptimer->timer_period = 0;
+}
+
+void os_timer_arm(os_timer_t *ptimer, uint32_t milliseconds, bool repeat_flag) {
+	os_timer_arm_us(ptimer, milliseconds * 1000, repeat_flag);
+}
+
+void os_timer_arm_us(os_timer_t *ptimer, uint32_t microseconds, bool repeat_flag) {
+	ptimer->timer_period = microseconds > 0 ? microseconds : 1;
+	ptimer->timer_repeat = repeat_flag;
+}
+
+void os_timer_disarm(os_timer_t *ptimer) {
+	ptimer->timer_period = 0;
+}
@@ -0,0 +1,37 @@
+/***************************************************
+
+  KniwwelinoLIB host build
+
+  Stand-in for the os_timer part of the ESP8266 SDK. As with Ticker the
+  timers only keep their settings, nothing fires on its own.
+
+ ****************************************************/
+#ifndef KniwwelinoHost_user_interface_h
+#define KniwwelinoHost_user_interface_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void os_timer_func_t(void *arg);
+
+typedef struct _os_timer_t {
+	os_timer_func_t *timer_func;
+	void *timer_arg;
+	uint32_t timer_period;		// microseconds, 0 = disarmed
+	bool timer_repeat;
+} os_timer_t;
+
+void os_timer_setfn(os_timer_t *ptimer, os_timer_func_t *pfunction, void *parg);
+void os_timer_arm(os_timer_t *ptimer, uint32_t milliseconds, bool repeat_flag);
+void os_timer_arm_us(os_timer_t *ptimer, uint32_t microseconds, bool repeat_flag);
+void os_timer_disarm(os_timer_t *ptimer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif